@@ -292,7 +292,7 @@ void onUrlSuccess(JNIEnv* _jniEnv, jbyteArray _jBytes, jlong _jCallbackPtr) {
     _jniEnv->GetByteArrayRegion(_jBytes, 0, length, reinterpret_cast<jbyte*>(content.data()));
 
     UrlCallback* callback = reinterpret_cast<UrlCallback*>(_jCallbackPtr);
-    (*callback)(std::move(content));
+    (*callback)(std::move(content), true);
     delete callback;
 }
 
@@ -300,7 +300,7 @@ void onUrlFailure(JNIEnv* _jniEnv, jlong _jCallbackPtr) {
     std::vector<char> empty;
 
     UrlCallback* callback = reinterpret_cast<UrlCallback*>(_jCallbackPtr);
-    (*callback)(std::move(empty));
+    (*callback)(std::move(empty), false);
     delete callback;
 }
 
@@ -1,8 +1,16 @@
 #include "tangram.h"
 #include "gl.h"
-
+#include "platform.h"
+#include "data/dataSource.h"
+#include "scene/sceneLoader.h"
+#include "scene/scene.h"
 #include "util/builders.h"
+#include "util/mapProjection.h"
+#include "tile/tile.h"
+#include "tile/tileTask.h"
+
 #include "glm/glm.hpp"
+#include <fstream>
 #include <vector>
 
 #include "benchmark/benchmark_api.h"
@@ -58,4 +66,119 @@ static void BM_Tangram_BuildRoundRoundLine(benchmark::State& state) {
 }
 BENCHMARK(BM_Tangram_BuildRoundRoundLine);
 
+// Building the lines of a real tile, emitting vertices through the
+// std::function of PolyLineBuilder or through a lambda that the templated
+// Builders::buildPolyLine() inlines.
+
+struct TestContext {
+
+    MercatorProjection s_projection;
+
+    std::shared_ptr<Scene> scene;
+    std::shared_ptr<DataSource> source;
+
+    RawBuffer rawTileData;
+    std::shared_ptr<TileData> tileData;
+
+    void loadScene(const char* sceneFile) {
+        scene = std::make_shared<Scene>(sceneFile);
+        auto sceneString = stringFromFile(sceneFile);
+
+        YAML::Node sceneNode;
+
+        try { sceneNode = YAML::Load(sceneString); }
+        catch (YAML::ParserException e) {
+            LOGE("Parsing scene config '%s'", e.what());
+            return;
+        }
+        SceneLoader::applyConfig(sceneNode, *scene);
+
+        source = *scene->dataSources().begin();
+    }
+
+    void loadTile(const char* path){
+        std::ifstream resource(path, std::ifstream::ate | std::ifstream::binary);
+        if(!resource.is_open()) {
+            LOGE("Failed to read file at path: %s", path);
+            return;
+        }
+
+        size_t _size = resource.tellg();
+        resource.seekg(std::ifstream::beg);
+
+        std::vector<char> data(_size);
+
+        resource.read(&data[0], _size);
+        resource.close();
+
+        rawTileData = RawBuffer(std::move(data));
+    }
+
+    void parseTile() {
+        Tile tile({0,0,10,10,0}, s_projection);
+        auto task = source->createTask(tile.getID());
+        auto& t = dynamic_cast<DownloadTileTask&>(*task);
+        t.rawTileData = rawTileData;
+
+        tileData = source->parse(*task, s_projection);
+    }
+};
+
+class StreetLinesFixture : public benchmark::Fixture {
+public:
+    TestContext ctx;
+    std::vector<const Line*> lines;
+
+    void SetUp() override {
+        ctx.loadScene("scene.yaml");
+        ctx.loadTile("tile.mvt");
+        ctx.parseTile();
+
+        lines.clear();
+        for (const auto& layer : ctx.tileData->layers) {
+            for (const auto& feature : layer.features) {
+                if (feature.geometryType != GeometryType::lines) { continue; }
+                for (const auto& line : feature.lines) {
+                    if (line.size() > 1) { lines.push_back(&line); }
+                }
+            }
+        }
+    }
+};
+
+BENCHMARK_DEFINE_F(StreetLinesFixture, BuildStreetLines)(benchmark::State& st) {
+
+    bool inlined = st.range_x();
+
+    std::vector<PosNormEnormColVertex> vertices;
+    auto addVertex = [&](const glm::vec3& coord, const glm::vec2& normal, const glm::vec2& uv) {
+        vertices.push_back({ coord, uv, normal, 0.5f, 0xffffff, 0.f });
+    };
+
+    PolyLineBuilder builder { addVertex, CapTypes::round, JoinTypes::miter };
+    size_t numVertices = 0;
+
+    while (st.KeepRunning()) {
+        numVertices = 0;
+
+        for (const auto* line : lines) {
+            if (inlined) {
+                Builders::buildPolyLine(*line, builder, addVertex);
+            } else {
+                Builders::buildPolyLine(*line, builder);
+            }
+            numVertices += vertices.size();
+            vertices.clear();
+            builder.clear();
+        }
+    }
+
+    st.SetItemsProcessed(st.iterations() * numVertices);
+    st.SetLabel(std::string(inlined ? "inlined" : "std::function") + ", " +
+                std::to_string(lines.size()) + " lines, " +
+                std::to_string(numVertices) + " vertices");
+}
+
+BENCHMARK_REGISTER_F(StreetLinesFixture, BuildStreetLines)->Arg(0)->Arg(1);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,160 @@
+#include "tangram.h"
+#include "platform.h"
+#include "data/dataSource.h"
+#include "scene/filterProgram.h"
+#include "scene/sceneLoader.h"
+#include "scene/scene.h"
+#include "scene/styleContext.h"
+#include "util/mapProjection.h"
+#include "tile/tile.h"
+#include "tile/tileTask.h"
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+// Matching the features of a tile against the layer filters of a scene,
+// walking the Filter trees of each layer or running its FilterProgram.
+
+struct TestContext {
+
+    MercatorProjection s_projection;
+
+    std::shared_ptr<Scene> scene;
+    std::shared_ptr<DataSource> source;
+    StyleContext styleContext;
+
+    RawBuffer rawTileData;
+    std::shared_ptr<TileData> tileData;
+
+    void loadScene(const char* sceneFile) {
+        scene = std::make_shared<Scene>(sceneFile);
+        auto sceneString = stringFromFile(sceneFile);
+
+        YAML::Node sceneNode;
+
+        try { sceneNode = YAML::Load(sceneString); }
+        catch (YAML::ParserException e) {
+            LOGE("Parsing scene config '%s'", e.what());
+            return;
+        }
+        SceneLoader::applyConfig(sceneNode, *scene);
+
+        styleContext.initFunctions(*scene);
+        styleContext.setKeywordZoom(10);
+
+        source = *scene->dataSources().begin();
+    }
+
+    void loadTile(const char* path){
+        std::ifstream resource(path, std::ifstream::ate | std::ifstream::binary);
+        if(!resource.is_open()) {
+            LOGE("Failed to read file at path: %s", path);
+            return;
+        }
+
+        size_t _size = resource.tellg();
+        resource.seekg(std::ifstream::beg);
+
+        std::vector<char> data(_size);
+
+        resource.read(&data[0], _size);
+        resource.close();
+
+        rawTileData = RawBuffer(std::move(data));
+    }
+
+    void parseTile() {
+        Tile tile({0,0,10,10,0}, s_projection);
+        auto task = source->createTask(tile.getID());
+        auto& t = dynamic_cast<DownloadTileTask&>(*task);
+        t.rawTileData = rawTileData;
+
+        tileData = source->parse(*task, s_projection);
+    }
+};
+
+class FilterFixture : public benchmark::Fixture {
+public:
+    TestContext ctx;
+
+    void SetUp() override {
+        ctx.loadScene("scene.yaml");
+        ctx.loadTile("tile.mvt");
+        ctx.parseTile();
+    }
+};
+
+static size_t matchTree(const SceneLayer& _layer, const Feature& _feature, StyleContext& _ctx) {
+    if (!_layer.visible() || !_layer.filter().eval(_feature, _ctx)) { return 0; }
+
+    size_t matches = 1;
+    for (const auto& sublayer : _layer.sublayers()) {
+        matches += matchTree(sublayer, _feature, _ctx);
+    }
+    return matches;
+}
+
+static size_t matchProgram(const SceneLayer& _layer, const FilterProgram& _program,
+                           const Feature& _feature, StyleContext& _ctx, FilterProgram::State& _state) {
+    if (!_layer.visible() || !_program.eval(_layer.filterId(), _feature, _ctx, _state)) { return 0; }
+
+    size_t matches = 1;
+    for (const auto& sublayer : _layer.sublayers()) {
+        matches += matchProgram(sublayer, _program, _feature, _ctx, _state);
+    }
+    return matches;
+}
+
+BENCHMARK_DEFINE_F(FilterFixture, MatchLayers)(benchmark::State& st) {
+
+    bool compiled = st.range_x();
+
+    FilterProgram::State state;
+    size_t features = 0;
+    size_t matches = 0;
+
+    while (st.KeepRunning()) {
+        features = 0;
+        matches = 0;
+
+        for (const auto& datalayer : ctx.scene->layers()) {
+            if (datalayer.source() != ctx.source->name()) { continue; }
+
+            const auto& dlc = datalayer.collections();
+
+            for (const auto& collection : ctx.tileData->layers) {
+                if (!collection.name.empty() &&
+                    std::find(dlc.begin(), dlc.end(), collection.name) == dlc.end()) {
+                    continue;
+                }
+
+                for (const auto& feature : collection.features) {
+                    ctx.styleContext.setFeature(feature);
+                    features++;
+
+                    if (compiled) {
+                        const auto& program = *datalayer.filterProgram();
+                        program.begin(state);
+                        matches += matchProgram(datalayer, program, feature, ctx.styleContext, state);
+                    } else {
+                        matches += matchTree(datalayer, feature, ctx.styleContext);
+                    }
+                }
+            }
+        }
+    }
+
+    st.SetLabel(std::string(compiled ? "FilterProgram" : "Filter trees") + ", " +
+                std::to_string(features) + " features, " +
+                std::to_string(matches) + " layer matches");
+}
+
+BENCHMARK_REGISTER_F(FilterFixture, MatchLayers)->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,95 @@
+#include "util/pbfParser.h"
+#include "util/varint.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+// Decoding of the feature geometries of a vector tile, one varint at a time
+// through protobuf::message or with the batched Varint decoder.
+
+static std::vector<char> loadTile(const char* _path) {
+    std::ifstream resource(_path, std::ifstream::ate | std::ifstream::binary);
+    if (!resource.is_open()) { return {}; }
+
+    std::vector<char> data(resource.tellg());
+    resource.seekg(std::ifstream::beg);
+    resource.read(data.data(), data.size());
+
+    return data;
+}
+
+struct Geometries {
+    std::vector<char> rawData;
+    std::vector<protobuf::message> messages;
+    int64_t bytes = 0;
+
+    Geometries(const char* _path) : rawData(loadTile(_path)) {
+        protobuf::message tile(rawData.data(), rawData.size());
+        while (tile.next()) {
+            if (tile.tag != 3) { tile.skip(); continue; }
+            auto layer = tile.getMessage();
+            while (layer.next()) {
+                if (layer.tag != 2) { layer.skip(); continue; }
+                auto feature = layer.getMessage();
+                while (feature.next()) {
+                    if (feature.tag != 4) { feature.skip(); continue; }
+                    auto geom = feature.getMessage();
+                    bytes += geom.getEnd() - geom.getData();
+                    messages.push_back(geom);
+                }
+            }
+        }
+    }
+};
+
+static void decodeVarints(benchmark::State& state) {
+    static const Geometries geometries("tile.mvt");
+
+    bool batched = state.range_x();
+
+    std::vector<uint32_t> values;
+    int64_t sum = 0;
+
+    while (state.KeepRunning()) {
+        for (auto geom : geometries.messages) {
+            if (batched) {
+                const char* data = geom.getData();
+                const char* end = geom.getEnd();
+                values.resize(end - data);
+                size_t n = Varint::decode(data, end, values.data(), values.size());
+                for (size_t i = 0; i < n; i++) { sum += values[i]; }
+            } else {
+                while (geom.getData() < geom.getEnd()) { sum += geom.varint(); }
+            }
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+
+    state.SetBytesProcessed(state.iterations() * geometries.bytes);
+    state.SetLabel(batched ? "batched" : "protobuf::message");
+}
+BENCHMARK(decodeVarints)->Arg(0)->Arg(1);
+
+static void decodeGeometry(benchmark::State& state) {
+    static const Geometries geometries("tile.mvt");
+
+    PbfParser::ParserContext ctx(0);
+    ctx.tileExtent = 4096;
+
+    while (state.KeepRunning()) {
+        for (auto geom : geometries.messages) {
+            PbfParser::getGeometry(ctx, geom);
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * geometries.bytes);
+}
+BENCHMARK(decodeGeometry);
+
+BENCHMARK_MAIN();
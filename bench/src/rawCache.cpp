@@ -0,0 +1,84 @@
+#include "tangram.h"
+#include "data/rawCache.h"
+
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+#define CACHE_SIZE (16 * 1024 * 1024)
+#define TILE_SIZE (32 * 1024)
+#define NUM_TILES 256
+
+// Lookups of the main thread while range_x() network threads store tiles
+static void BM_Tangram_RawCache_GetContended(benchmark::State& state) {
+    int numWriters = state.range_x();
+
+    RawCache cache;
+    cache.setMaxUsage(CACHE_SIZE);
+
+    RawBuffer data(std::vector<char>(TILE_SIZE));
+    for (int i = 0; i < NUM_TILES; i++) {
+        cache.put(TileID(i % 16, i / 16, 8), data);
+    }
+
+    std::atomic<bool> running(true);
+    std::vector<std::thread> writers;
+    for (int i = 0; i < numWriters; i++) {
+        writers.emplace_back([&, i]() {
+            std::minstd_rand random(i);
+            while (running) {
+                int tile = random() % NUM_TILES;
+                cache.put(TileID(tile % 16, tile / 16, 8), data);
+            }
+        });
+    }
+
+    int tile = 0;
+    RawBuffer result;
+    while (state.KeepRunning()) {
+        tile = (tile + 1) % NUM_TILES;
+        benchmark::DoNotOptimize(cache.get(TileID(tile % 16, tile / 16, 8), result));
+    }
+
+    running = false;
+    for (auto& writer : writers) { writer.join(); }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Tangram_RawCache_GetContended)->Arg(0)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+
+// Mixed lookups and stores from range_x() threads, as from workers and network threads
+static void BM_Tangram_RawCache_Mixed(benchmark::State& state) {
+    int numThreads = state.range_x();
+
+    RawCache cache;
+    cache.setMaxUsage(CACHE_SIZE);
+
+    RawBuffer data(std::vector<char>(TILE_SIZE));
+
+    while (state.KeepRunning()) {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < numThreads; i++) {
+            threads.emplace_back([&, i]() {
+                std::minstd_rand random(i);
+                RawBuffer result;
+                for (int n = 0; n < 10000; n++) {
+                    int tile = random() % (NUM_TILES * 4);
+                    TileID id(tile % 32, tile / 32, 9);
+                    if (!cache.get(id, result)) { cache.put(id, data); }
+                }
+            });
+        }
+        for (auto& thread : threads) { thread.join(); }
+    }
+    state.SetItemsProcessed(state.iterations() * numThreads * 10000);
+}
+BENCHMARK(BM_Tangram_RawCache_Mixed)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+BENCHMARK_MAIN();
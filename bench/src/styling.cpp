@@ -0,0 +1,175 @@
+#include "tangram.h"
+#include "platform.h"
+#include "data/dataSource.h"
+#include "scene/drawRule.h"
+#include "scene/sceneLoader.h"
+#include "scene/scene.h"
+#include "scene/stops.h"
+#include "scene/styleContext.h"
+#include "util/mapProjection.h"
+#include "tile/tile.h"
+#include "tile/tileTask.h"
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+// Resolving the draw rule params of the features of a tile after matching,
+// evaluating Stops for each feature or reading them from the per-zoom table
+// of DrawRuleMergeSet.
+
+struct TestContext {
+
+    MercatorProjection s_projection;
+
+    std::shared_ptr<Scene> scene;
+    std::shared_ptr<DataSource> source;
+    StyleContext styleContext;
+
+    RawBuffer rawTileData;
+    std::shared_ptr<TileData> tileData;
+
+    void loadScene(const char* sceneFile) {
+        scene = std::make_shared<Scene>(sceneFile);
+        auto sceneString = stringFromFile(sceneFile);
+
+        YAML::Node sceneNode;
+
+        try { sceneNode = YAML::Load(sceneString); }
+        catch (YAML::ParserException e) {
+            LOGE("Parsing scene config '%s'", e.what());
+            return;
+        }
+        SceneLoader::applyConfig(sceneNode, *scene);
+
+        styleContext.initFunctions(*scene);
+        styleContext.setKeywordZoom(10);
+
+        source = *scene->dataSources().begin();
+    }
+
+    void loadTile(const char* path){
+        std::ifstream resource(path, std::ifstream::ate | std::ifstream::binary);
+        if(!resource.is_open()) {
+            LOGE("Failed to read file at path: %s", path);
+            return;
+        }
+
+        size_t _size = resource.tellg();
+        resource.seekg(std::ifstream::beg);
+
+        std::vector<char> data(_size);
+
+        resource.read(&data[0], _size);
+        resource.close();
+
+        rawTileData = RawBuffer(std::move(data));
+    }
+
+    void parseTile() {
+        Tile tile({0,0,10,10,0}, s_projection);
+        auto task = source->createTask(tile.getID());
+        auto& t = dynamic_cast<DownloadTileTask&>(*task);
+        t.rawTileData = rawTileData;
+
+        tileData = source->parse(*task, s_projection);
+    }
+};
+
+class StylingFixture : public benchmark::Fixture {
+public:
+    TestContext ctx;
+
+    void SetUp() override {
+        ctx.loadScene("scene.yaml");
+        ctx.loadTile("tile.mvt");
+        ctx.parseTile();
+    }
+};
+
+// DrawRuleMergeSet::evaluateRule() as it was before the per-zoom table
+static bool evaluatePerFeature(DrawRule& _rule, StyleContext& _ctx, StyleParam* _evaluated) {
+
+    for (size_t i = 0; i < StyleParamKeySize; ++i) {
+
+        if (!_rule.active[i]) {
+            _rule.params[i].param = nullptr;
+            continue;
+        }
+
+        auto*& param = _rule.params[i].param;
+
+        if (param->function >= 0) {
+            _evaluated[i] = *param;
+            param = &_evaluated[i];
+
+            if (!_ctx.evalStyle(param->function, param->key, _evaluated[i].value)) {
+                if (StyleParam::isRequired(param->key)) { return false; }
+                _rule.active[i] = false;
+            }
+        } else if (param->stops) {
+            _evaluated[i] = *param;
+            param = &_evaluated[i];
+
+            Stops::eval(*param->stops, param->key, _ctx.getKeywordZoom(), _evaluated[i].value);
+        }
+    }
+    return true;
+}
+
+BENCHMARK_DEFINE_F(StylingFixture, EvaluateRules)(benchmark::State& st) {
+
+    bool zoomTable = st.range_x();
+
+    DrawRuleMergeSet ruleSet;
+    StyleParam evaluated[StyleParamKeySize];
+
+    size_t features = 0;
+    size_t rules = 0;
+
+    while (st.KeepRunning()) {
+        features = 0;
+        rules = 0;
+
+        for (const auto& datalayer : ctx.scene->layers()) {
+            if (datalayer.source() != ctx.source->name()) { continue; }
+
+            const auto& dlc = datalayer.collections();
+
+            for (const auto& collection : ctx.tileData->layers) {
+                if (!collection.name.empty() &&
+                    std::find(dlc.begin(), dlc.end(), collection.name) == dlc.end()) {
+                    continue;
+                }
+
+                for (const auto& feature : collection.features) {
+                    features++;
+                    if (!ruleSet.matchCached(feature, datalayer, ctx.styleContext)) { continue; }
+
+                    for (auto& rule : ruleSet.matchedRules()) {
+                        if (zoomTable) {
+                            ruleSet.evaluateRule(rule, ctx.styleContext);
+                        } else {
+                            evaluatePerFeature(rule, ctx.styleContext, evaluated);
+                        }
+                        benchmark::DoNotOptimize(rule.params[0].param);
+                        rules++;
+                    }
+                }
+            }
+        }
+    }
+
+    st.SetLabel(std::string(zoomTable ? "per-zoom table" : "per-feature Stops") + ", " +
+                std::to_string(features) + " features, " +
+                std::to_string(rules) + " rules");
+}
+
+BENCHMARK_REGISTER_F(StylingFixture, EvaluateRules)->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,144 @@
+#include "tangram.h"
+#include "platform.h"
+#include "data/dataSource.h"
+#include "scene/sceneLoader.h"
+#include "scene/scene.h"
+#include "util/builders.h"
+#include "util/mapProjection.h"
+#include "util/tessellationCache.h"
+#include "tile/tile.h"
+#include "tile/tileTask.h"
+
+#include <fstream>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+// Triangulating the polygons of a tile as it is rebuilt after scene updates:
+// each iteration parses the tile again and builds all of its polygons, with
+// earcut or with a TessellationCache that was filled by the first build.
+
+struct TestContext {
+
+    MercatorProjection s_projection;
+
+    std::shared_ptr<Scene> scene;
+    std::shared_ptr<DataSource> source;
+
+    RawBuffer rawTileData;
+    std::shared_ptr<TileData> tileData;
+
+    void loadScene(const char* sceneFile) {
+        scene = std::make_shared<Scene>(sceneFile);
+        auto sceneString = stringFromFile(sceneFile);
+
+        YAML::Node sceneNode;
+
+        try { sceneNode = YAML::Load(sceneString); }
+        catch (YAML::ParserException e) {
+            LOGE("Parsing scene config '%s'", e.what());
+            return;
+        }
+        SceneLoader::applyConfig(sceneNode, *scene);
+
+        source = *scene->dataSources().begin();
+    }
+
+    void loadTile(const char* path){
+        std::ifstream resource(path, std::ifstream::ate | std::ifstream::binary);
+        if(!resource.is_open()) {
+            LOGE("Failed to read file at path: %s", path);
+            return;
+        }
+
+        size_t _size = resource.tellg();
+        resource.seekg(std::ifstream::beg);
+
+        std::vector<char> data(_size);
+
+        resource.read(&data[0], _size);
+        resource.close();
+
+        rawTileData = RawBuffer(std::move(data));
+    }
+
+    void parseTile() {
+        Tile tile({0,0,10,10,0}, s_projection);
+        auto task = source->createTask(tile.getID());
+        auto& t = dynamic_cast<DownloadTileTask&>(*task);
+        t.rawTileData = rawTileData;
+
+        tileData = source->parse(*task, s_projection);
+    }
+};
+
+class TessellationFixture : public benchmark::Fixture {
+public:
+    TestContext ctx;
+    TessellationCache cache;
+
+    void SetUp() override {
+        ctx.loadScene("scene.yaml");
+        ctx.loadTile("tile.mvt");
+        ctx.parseTile();
+
+        cache.setMaxUsage(16 * (1024 * 1024));
+    }
+};
+
+static size_t buildPolygons(const TileData& _tileData, PolygonBuilder& _builder) {
+    size_t numIndices = 0;
+
+    auto addVertex = [](const glm::vec3&, const glm::vec3&, const glm::vec2&) {};
+
+    for (const auto& layer : _tileData.layers) {
+        for (const auto& feature : layer.features) {
+            for (const auto& polygon : feature.polygons) {
+                Builders::buildPolygon(polygon, 0.f, _builder, addVertex);
+                numIndices += _builder.indices.size();
+                _builder.clear();
+            }
+        }
+    }
+    return numIndices;
+}
+
+BENCHMARK_DEFINE_F(TessellationFixture, RebuildPolygons)(benchmark::State& st) {
+
+    bool cached = st.range_x();
+
+    PolygonBuilder builder;
+    builder.useTexCoords = false;
+
+    if (cached) {
+        builder.cache = &cache;
+
+        // The first build of the tile
+        cache.clear();
+        buildPolygons(*ctx.tileData, builder);
+    }
+    size_t misses = cache.misses();
+
+    size_t numIndices = 0;
+
+    while (st.KeepRunning()) {
+        st.PauseTiming();
+        ctx.parseTile();
+        st.ResumeTiming();
+
+        numIndices = buildPolygons(*ctx.tileData, builder);
+    }
+
+    st.SetLabel(std::string(cached ? "TessellationCache" : "earcut") + ", " +
+                std::to_string(numIndices / 3) + " triangles, " +
+                std::to_string(cache.hits()) + " hits, " +
+                std::to_string(cache.misses() - misses) + " misses, " +
+                std::to_string(cache.usage()) + " bytes cached");
+}
+
+BENCHMARK_REGISTER_F(TessellationFixture, RebuildPolygons)->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,138 @@
+#include "tangram.h"
+#include "gl.h"
+#include "platform.h"
+#include "data/dataSource.h"
+#include "scene/sceneLoader.h"
+#include "scene/scene.h"
+#include "style/style.h"
+#include "util/mapProjection.h"
+#include "tile/tile.h"
+#include "tile/tileBuilder.h"
+#include "tile/tileTask.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+// Heap allocations made while building a tile. The first build of a
+// TileBuilder grows its scratch buffers, later builds of the same tile
+// should only allocate what is handed off to the Tile.
+
+static std::atomic<size_t> s_allocations(0);
+static std::atomic<size_t> s_allocatedBytes(0);
+
+void* operator new(size_t _size) {
+    s_allocations++;
+    s_allocatedBytes += _size;
+    if (void* ptr = std::malloc(_size)) { return ptr; }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* _ptr) noexcept {
+    std::free(_ptr);
+}
+
+void operator delete(void* _ptr, size_t) noexcept {
+    std::free(_ptr);
+}
+
+struct TestContext {
+
+    MercatorProjection s_projection;
+
+    std::shared_ptr<Scene> scene;
+    std::shared_ptr<DataSource> source;
+
+    RawBuffer rawTileData;
+    std::shared_ptr<TileData> tileData;
+
+    void loadScene(const char* sceneFile) {
+        scene = std::make_shared<Scene>(sceneFile);
+        auto sceneString = stringFromFile(sceneFile);
+
+        YAML::Node sceneNode;
+
+        try { sceneNode = YAML::Load(sceneString); }
+        catch (YAML::ParserException e) {
+            LOGE("Parsing scene config '%s'", e.what());
+            return;
+        }
+        SceneLoader::applyConfig(sceneNode, *scene);
+
+        source = *scene->dataSources().begin();
+    }
+
+    void loadTile(const char* path){
+        std::ifstream resource(path, std::ifstream::ate | std::ifstream::binary);
+        if(!resource.is_open()) {
+            LOGE("Failed to read file at path: %s", path);
+            return;
+        }
+
+        size_t _size = resource.tellg();
+        resource.seekg(std::ifstream::beg);
+
+        std::vector<char> data(_size);
+
+        resource.read(&data[0], _size);
+        resource.close();
+
+        rawTileData = RawBuffer(std::move(data));
+    }
+
+    void parseTile() {
+        Tile tile({0,0,10,10,0}, s_projection);
+        auto task = source->createTask(tile.getID());
+        auto& t = dynamic_cast<DownloadTileTask&>(*task);
+        t.rawTileData = rawTileData;
+
+        tileData = source->parse(*task, s_projection);
+    }
+};
+
+class TileBuildAllocationsFixture : public benchmark::Fixture {
+public:
+    TestContext ctx;
+
+    void SetUp() override {
+        ctx.loadScene("scene.yaml");
+        ctx.loadTile("tile.mvt");
+        ctx.parseTile();
+    }
+};
+
+BENCHMARK_DEFINE_F(TileBuildAllocationsFixture, AllocationsPerTile)(benchmark::State& st) {
+
+    TileBuilder builder(ctx.scene);
+
+    // Warm up the scratch buffers of the builder
+    builder.build({0,0,10,10,0}, *ctx.tileData, *ctx.source);
+
+    size_t tiles = 0;
+    size_t allocations = s_allocations;
+    size_t bytes = s_allocatedBytes;
+
+    while (st.KeepRunning()) {
+        auto tile = builder.build({0,0,10,10,0}, *ctx.tileData, *ctx.source);
+        benchmark::DoNotOptimize(tile.get());
+        tiles++;
+    }
+
+    allocations = s_allocations - allocations;
+    bytes = s_allocatedBytes - bytes;
+
+    st.SetLabel(std::to_string(allocations / std::max<size_t>(tiles, 1)) + " allocations, " +
+                std::to_string(bytes / std::max<size_t>(tiles, 1)) + " bytes per tile");
+}
+
+BENCHMARK_REGISTER_F(TileBuildAllocationsFixture, AllocationsPerTile);
+
+BENCHMARK_MAIN();
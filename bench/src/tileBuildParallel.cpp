@@ -0,0 +1,114 @@
+#include "tangram.h"
+#include "gl.h"
+#include "platform.h"
+#include "data/dataSource.h"
+#include "scene/sceneLoader.h"
+#include "scene/scene.h"
+#include "style/style.h"
+#include "util/mapProjection.h"
+#include "tile/tile.h"
+#include "tile/tileBuilder.h"
+#include "tile/tileTask.h"
+#include "tile/tileWorker.h"
+
+#include <vector>
+#include <fstream>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+// Latency of building one large tile, against the number of partitions the
+// build is split into. Each partition beyond the first runs on its own worker.
+
+struct TestContext {
+
+    MercatorProjection s_projection;
+
+    std::shared_ptr<Scene> scene;
+    std::shared_ptr<DataSource> source;
+
+    RawBuffer rawTileData;
+    std::shared_ptr<TileData> tileData;
+
+    void loadScene(const char* sceneFile) {
+        scene = std::make_shared<Scene>(sceneFile);
+        auto sceneString = stringFromFile(sceneFile);
+
+        YAML::Node sceneNode;
+
+        try { sceneNode = YAML::Load(sceneString); }
+        catch (YAML::ParserException e) {
+            LOGE("Parsing scene config '%s'", e.what());
+            return;
+        }
+        SceneLoader::applyConfig(sceneNode, *scene);
+
+        source = *scene->dataSources().begin();
+    }
+
+    void loadTile(const char* path){
+        std::ifstream resource(path, std::ifstream::ate | std::ifstream::binary);
+        if(!resource.is_open()) {
+            LOGE("Failed to read file at path: %s", path);
+            return;
+        }
+
+        size_t _size = resource.tellg();
+        resource.seekg(std::ifstream::beg);
+
+        std::vector<char> data(_size);
+
+        resource.read(&data[0], _size);
+        resource.close();
+
+        rawTileData = RawBuffer(std::move(data));
+    }
+
+    void parseTile() {
+        Tile tile({0,0,10,10,0}, s_projection);
+        auto task = source->createTask(tile.getID());
+        auto& t = dynamic_cast<DownloadTileTask&>(*task);
+        t.rawTileData = rawTileData;
+
+        tileData = source->parse(*task, s_projection);
+    }
+};
+
+class TileBuildParallelFixture : public benchmark::Fixture {
+public:
+    TestContext ctx;
+
+    void SetUp() override {
+        ctx.loadScene("scene.yaml");
+        ctx.loadTile("tile.mvt");
+        ctx.parseTile();
+    }
+};
+
+BENCHMARK_DEFINE_F(TileBuildParallelFixture, BuildLatency)(benchmark::State& st) {
+
+    int partitions = st.range_x();
+
+    TileWorker workers(partitions - 1);
+
+    TileBuilder builder(ctx.scene);
+    if (partitions > 1) {
+        builder.setParallel(partitions, [&](auto& _jobs) { workers.runParallel(_jobs); });
+    }
+
+    size_t meshBytes = 0;
+
+    while (st.KeepRunning()) {
+        auto tile = builder.build({0,0,10,10,0}, *ctx.tileData, *ctx.source);
+        meshBytes = tile->getMemoryUsage();
+    }
+
+    st.SetLabel(std::to_string(partitions) + " partitions, " +
+                std::to_string(meshBytes) + " bytes");
+}
+
+BENCHMARK_REGISTER_F(TileBuildParallelFixture, BuildLatency)->Arg(1)->Arg(2)->Arg(4);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,155 @@
+#include "tangram.h"
+#include "style/polygonStyle.h"
+#include "tile/tileCache.h"
+#include "util/mapProjection.h"
+
+#include <cmath>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+#define CACHE_SIZE (32 * 1024 * 1024)
+#define TILE_SIZE (512 * 1024)
+// Viewport in tiles at integer zoom
+#define VIEW_TILES_X 4
+#define VIEW_TILES_Y 3
+
+struct BenchMesh : StyledMesh {
+    size_t size;
+    BenchMesh(size_t _size) : size(_size) {}
+    bool draw(ShaderProgram& _shader) override { return false; }
+    size_t bufferSize() const override { return size; }
+};
+
+struct Camera {
+    // Position in [0, 1] of the projection
+    double x, y;
+    float zoom;
+};
+
+static MercatorProjection s_projection;
+
+static std::shared_ptr<Tile> makeTile(TileID _id) {
+    static PolygonStyle style("bench");
+    style.setID(0);
+
+    auto tile = std::make_shared<Tile>(_id, s_projection);
+    tile->setMesh(style, std::make_unique<BenchMesh>(TILE_SIZE));
+    return tile;
+}
+
+static std::set<TileID> visibleTiles(const Camera& _camera) {
+    std::set<TileID> tiles;
+
+    int z = std::floor(_camera.zoom);
+    int n = 1 << z;
+    double scale = std::exp2(z - _camera.zoom);
+    double cx = _camera.x * n, cy = _camera.y * n;
+    double hw = 0.5 * VIEW_TILES_X * scale, hh = 0.5 * VIEW_TILES_Y * scale;
+
+    for (int x = std::floor(cx - hw); x <= std::floor(cx + hw); x++) {
+        for (int y = std::floor(cy - hh); y <= std::floor(cy + hh); y++) {
+            if (x >= 0 && x < n && y >= 0 && y < n) { tiles.emplace(x, y, z); }
+        }
+    }
+    return tiles;
+}
+
+// Camera paths in the style of recorded sessions: browsing around a few
+// favorite places, zooming out to travel between them and zooming in and
+// out to look at details
+static std::vector<Camera> cameraPath(int _seed) {
+    std::vector<Camera> path;
+    std::minstd_rand random(_seed);
+    std::uniform_real_distribution<double> unit(-1, 1);
+
+    std::vector<Camera> places;
+    for (int i = 0; i < 5; i++) {
+        places.push_back({ 0.5117 + unit(random) * 0.002, 0.3402 + unit(random) * 0.002, 15 });
+    }
+    Camera camera = places[0];
+
+    for (int trip = 0; trip < 100; trip++) {
+        int kind = random() % 3;
+
+        if (kind == 0) {
+            // Travel to another place
+            Camera target = places[random() % places.size()];
+            for (; camera.zoom > 11; camera.zoom -= 0.25f) { path.push_back(camera); }
+            for (int i = 0; i < 20; i++) {
+                camera.x += (target.x - camera.x) * 0.25;
+                camera.y += (target.y - camera.y) * 0.25;
+                path.push_back(camera);
+            }
+            camera.x = target.x;
+            camera.y = target.y;
+            for (; camera.zoom < target.zoom; camera.zoom += 0.25f) { path.push_back(camera); }
+        } else if (kind == 1) {
+            // Pan around, a tenth of a tile per frame
+            float step = 0.1f / (1 << int(camera.zoom));
+            double dx = unit(random) * step, dy = unit(random) * step;
+            for (int i = 0; i < 60; i++) { camera.x += dx; camera.y += dy; path.push_back(camera); }
+            for (int i = 0; i < 60; i++) { camera.x -= dx; camera.y -= dy; path.push_back(camera); }
+        } else {
+            // Zoom in on details and back out
+            float zoom = camera.zoom;
+            for (; camera.zoom < zoom + 2; camera.zoom += 0.25f) { path.push_back(camera); }
+            for (; camera.zoom > zoom; camera.zoom -= 0.25f) { path.push_back(camera); }
+            camera.zoom = zoom;
+        }
+    }
+    return path;
+}
+
+static void BM_Tangram_TileCache_Replay(benchmark::State& state) {
+    auto path = cameraPath(state.range_x());
+
+    std::map<int, TileCacheStats> zoomStats;
+    TileCacheStats total;
+
+    while (state.KeepRunning()) {
+        TileCache cache(CACHE_SIZE);
+        std::map<TileID, std::shared_ptr<Tile>> visible;
+
+        for (auto& camera : path) {
+            auto tiles = visibleTiles(camera);
+
+            for (auto it = visible.begin(); it != visible.end();) {
+                if (tiles.count(it->first) == 0) {
+                    cache.put(0, it->second);
+                    it = visible.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            for (auto& id : tiles) {
+                if (visible.count(id)) { continue; }
+                auto tile = cache.get(0, id);
+                visible[id] = tile ? tile : makeTile(id);
+            }
+        }
+
+        for (int z = 0; z <= TileCache::MAX_ZOOM_STATS; z++) {
+            if (cache.getStats(z).requests > 0) { zoomStats[z] = cache.getStats(z); }
+        }
+        total = cache.getTotalStats();
+    }
+
+    std::stringstream label;
+    label << "hit ratio " << int(total.hitRatio() * 100) << "%";
+    for (auto& stats : zoomStats) {
+        label << " z" << stats.first << ":" << int(stats.second.hitRatio() * 100) << "%";
+    }
+    state.SetLabel(label.str());
+    state.SetItemsProcessed(state.iterations() * path.size());
+}
+BENCHMARK(BM_Tangram_TileCache_Replay)->Arg(1)->Arg(2)->Arg(3);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,74 @@
+#include "data/tileData.h"
+#include "util/pbfParser.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+// Heap allocations made while parsing a vector tile, with the geometry of
+// the TileData allocated from its arena or one container at a time.
+
+static size_t s_allocations = 0;
+
+void* operator new(size_t _size) {
+    s_allocations++;
+    if (void* ptr = std::malloc(_size)) { return ptr; }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* _ptr) noexcept {
+    std::free(_ptr);
+}
+
+static std::vector<char> loadTile(const char* _path) {
+    std::ifstream resource(_path, std::ifstream::ate | std::ifstream::binary);
+    if (!resource.is_open()) { return {}; }
+
+    std::vector<char> data(resource.tellg());
+    resource.seekg(std::ifstream::beg);
+    resource.read(data.data(), data.size());
+
+    return data;
+}
+
+static void parseTile(benchmark::State& state) {
+    static const std::vector<char> rawData = loadTile("tile.mvt");
+
+    bool useArena = state.range_x();
+
+    size_t allocations = 0;
+    size_t tiles = 0;
+
+    while (state.KeepRunning()) {
+        size_t start = s_allocations;
+
+        TileData tileData;
+        PbfParser::ParserContext ctx(0, nullptr, useArena ? tileData.arena.get() : nullptr);
+
+        protobuf::message item(rawData.data(), rawData.size());
+        while (item.next()) {
+            if (item.tag == 3) {
+                tileData.layers.push_back(PbfParser::getLayer(ctx, item.getMessage()));
+            } else {
+                item.skip();
+            }
+        }
+
+        allocations += s_allocations - start;
+        tiles++;
+    }
+
+    state.SetLabel(std::string(useArena ? "arena" : "heap") + ", " +
+                   std::to_string(allocations / std::max<size_t>(tiles, 1)) + " allocations per tile");
+}
+BENCHMARK(parseTile)->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
@@ -31,7 +31,7 @@ struct TestContext {
 
     std::shared_ptr<DataSource> source;
 
-    std::vector<char> rawTileData;
+    RawBuffer rawTileData;
 
     std::shared_ptr<TileData> tileData;
 
@@ -67,10 +67,12 @@ struct TestContext {
         size_t _size = resource.tellg();
         resource.seekg(std::ifstream::beg);
 
-        rawTileData.resize(_size);
+        std::vector<char> data(_size);
 
-        resource.read(&rawTileData[0], _size);
+        resource.read(&data[0], _size);
         resource.close();
+
+        rawTileData = RawBuffer(std::move(data));
     }
 
     void parseTile() {
@@ -78,7 +80,7 @@ struct TestContext {
         source = *scene->dataSources().begin();
         auto task = source->createTask(tile.getID());
         auto& t = dynamic_cast<DownloadTileTask&>(*task);
-        t.rawTileData = std::make_shared<std::vector<char>>(rawTileData);
+        t.rawTileData = rawTileData;
 
         tileData = source->parse(*task, s_projection);
     }
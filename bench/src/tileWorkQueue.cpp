@@ -0,0 +1,101 @@
+#include "tangram.h"
+#include "data/dataSource.h"
+#include "tile/tileTask.h"
+#include "tile/tileWorkQueue.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+struct BenchDataSource : DataSource {
+    BenchDataSource() : DataSource("", "") {}
+
+    std::shared_ptr<TileData> parse(const TileTask& _task,
+                                    const MapProjection& _projection) const override {
+        return nullptr;
+    }
+};
+
+static void fillQueue(TileWorkQueue& queue, std::shared_ptr<DataSource> source, int depth) {
+    for (int i = 0; i < depth; i++) {
+        TileID tileId(i, 0, 16);
+        auto task = std::make_shared<TileTask>(tileId, source, -1);
+        task->setPriority(depth - i);
+        task->setProxyState(i % 4 == 0);
+        // Simulate tiles that went out of view while waiting
+        if (i % 8 == 0) { task->cancel(); }
+
+        queue.push(std::move(task));
+    }
+}
+
+// range_x: number of workers, range_y: queue depth
+static void BM_Tangram_TileWorkQueue_Pop(benchmark::State& state) {
+    int numWorkers = state.range_x();
+    int depth = state.range_y();
+
+    auto source = std::make_shared<BenchDataSource>();
+
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        TileWorkQueue queue(numWorkers);
+        fillQueue(queue, source, depth);
+        state.ResumeTiming();
+
+        std::vector<std::thread> workers;
+        for (int i = 0; i < numWorkers; i++) {
+            workers.emplace_back([&queue, i]() {
+                std::shared_ptr<TileTask> task;
+                while (queue.pop(i, task)) {
+                    benchmark::DoNotOptimize(task);
+                }
+            });
+        }
+        for (auto& worker : workers) { worker.join(); }
+    }
+    state.SetItemsProcessed(state.iterations() * depth);
+}
+BENCHMARK(BM_Tangram_TileWorkQueue_Pop)->RangePair(1, 8, 64, 1024)->UseRealTime();
+
+// Producer pushes while the workers pop, as when tiles arrive from the network
+static void BM_Tangram_TileWorkQueue_PushPop(benchmark::State& state) {
+    int numWorkers = state.range_x();
+    int depth = state.range_y();
+
+    auto source = std::make_shared<BenchDataSource>();
+
+    while (state.KeepRunning()) {
+        TileWorkQueue queue(numWorkers);
+        std::atomic<int> popped(0);
+
+        std::vector<std::thread> workers;
+        for (int i = 0; i < numWorkers; i++) {
+            workers.emplace_back([&queue, &popped, i]() {
+                std::shared_ptr<TileTask> task;
+                while (queue.wait()) {
+                    if (queue.pop(i, task)) { popped++; }
+                }
+            });
+        }
+
+        fillQueue(queue, source, depth);
+
+        // Wait for the workers to drain the queue
+        while (queue.size() > 0) { std::this_thread::yield(); }
+
+        queue.stop();
+        for (auto& worker : workers) { worker.join(); }
+
+        benchmark::DoNotOptimize(popped.load());
+    }
+    state.SetItemsProcessed(state.iterations() * depth);
+}
+BENCHMARK(BM_Tangram_TileWorkQueue_PushPop)->RangePair(1, 8, 64, 1024)->UseRealTime();
+
+BENCHMARK_MAIN();
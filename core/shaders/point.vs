@@ -26,9 +26,9 @@ uniform LOWP int u_pass;
 
 attribute vec2 a_uv;
 attribute vec2 a_position;
-attribute LOWP float a_alpha;
 attribute LOWP vec4 a_color;
 #ifdef TANGRAM_TEXT
+attribute LOWP float a_alpha;
 attribute LOWP vec4 a_stroke;
 attribute float a_scale;
 #endif
@@ -49,8 +49,14 @@ varying float v_alpha;
 
 void main() {
 
+#ifdef TANGRAM_TEXT
     v_alpha = a_alpha;
     v_color = a_color;
+#else
+    // Sprites carry the label alpha in the color alpha
+    v_alpha = a_color.a;
+    v_color = vec4(a_color.rgb, 1.0);
+#endif
 
     vec2 vertex_pos = UNPACK_POSITION(a_position);
 
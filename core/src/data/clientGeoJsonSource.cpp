@@ -7,6 +7,7 @@
 #include "tangram.h"
 #include "tile/tileTask.h"
 #include "util/geom.h"
+#include "util/tessellationCache.h"
 #include "data/propertyItem.h"
 #include "data/tileData.h"
 #include "tile/tile.h"
@@ -44,7 +45,7 @@ ClientGeoJsonSource::ClientGeoJsonSource(const std::string& _name, const std::st
         std::smatch match;
         if (std::regex_search(_url, match, r)) {
             startUrlRequest(_url,
-                    [&, this](std::vector<char>&& rawData) {
+                    [&, this](std::vector<char>&& rawData, bool) {
                         addData(std::string(rawData.begin(), rawData.end()));
                         // delete all no-data tiles for this datasource and redo
                         clearDataSource(*this, false, true);
@@ -83,6 +84,7 @@ bool ClientGeoJsonSource::loadTileData(std::shared_ptr<TileTask>&& _task, TileTa
 void ClientGeoJsonSource::clearData() {
 
     m_features.clear();
+    m_tessellationCache->clear();
 
     std::lock_guard<std::mutex> lock(m_mutexStore);
     m_store.reset();
@@ -155,9 +157,11 @@ std::shared_ptr<TileData> ClientGeoJsonSource::parse(const TileTask& _task,
 
     Layer layer(""); // empty name will skip filtering by 'collection'
 
+    Arena* arena = data->arena.get();
+
     for (auto& it : tile.features) {
 
-        Feature feat(m_id);
+        Feature feat(m_id, arena);
 
         const auto& geom = it.tileGeometry;
         const auto type = it.type;
@@ -174,7 +178,7 @@ std::shared_ptr<TileData> ClientGeoJsonSource::parse(const TileTask& _task,
             case geojsonvt::TileFeatureType::LineString: {
                 feat.geometryType = GeometryType::lines;
                 for (const auto& r : geom) {
-                    Line line;
+                    Line line(arena);
                     for (const auto& pt : r.get<geojsonvt::TileRing>().points) {
                         line.push_back(transformPoint(pt));
                     }
@@ -185,14 +189,14 @@ std::shared_ptr<TileData> ClientGeoJsonSource::parse(const TileTask& _task,
             case geojsonvt::TileFeatureType::Polygon: {
                 feat.geometryType = GeometryType::polygons;
                 for (const auto& r : geom) {
-                    Line line;
+                    Line line(arena);
                     for (const auto& pt : r.get<geojsonvt::TileRing>().points) {
                         line.push_back(transformPoint(pt));
                     }
                     // Polygons are in a flat list of rings, with ccw rings indicating
                     // the beginning of a new polygon
                     if (signedArea(line.begin(), line.end()) >= 0 || feat.polygons.empty()) {
-                        feat.polygons.emplace_back();
+                        feat.polygons.emplace_back(arena);
                     }
                     feat.polygons.back().push_back(std::move(line));
                 }
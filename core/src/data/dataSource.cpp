@@ -1,4 +1,8 @@
 #include "dataSource.h"
+#include "data/diskCache.h"
+#include "data/rawCache.h"
+#include "util/simplify.h"
+#include "util/tessellationCache.h"
 #include "util/geoJson.h"
 #include "platform.h"
 #include "tileData.h"
@@ -8,8 +12,10 @@
 #include "tile/tileManager.h"
 #include "tile/tileTask.h"
 #include "gl/texture.h"
+#include "util/mapProjection.h"
 
 #include <atomic>
+#include <cmath>
 #include <mutex>
 #include <list>
 #include <functional>
@@ -17,80 +23,11 @@
 
 namespace Tangram {
 
-struct RawCache {
-
-    // Used to ensure safe access from async loading threads
-    std::mutex m_mutex;
-
-    // LRU in-memory cache for raw tile data
-    using CacheEntry = std::pair<TileID, std::shared_ptr<std::vector<char>>>;
-    using CacheList = std::list<CacheEntry>;
-    using CacheMap = std::unordered_map<TileID, typename CacheList::iterator>;
-
-    CacheMap m_cacheMap;
-    CacheList m_cacheList;
-    int m_usage = 0;
-    int m_maxUsage = 0;
-
-    bool get(DownloadTileTask& _task) {
-
-        if (m_maxUsage <= 0) { return false; }
-
-        std::lock_guard<std::mutex> lock(m_mutex);
-        TileID id(_task.tileId().x, _task.tileId().y, _task.tileId().z);
-
-        auto it = m_cacheMap.find(id);
-        if (it != m_cacheMap.end()) {
-            // Move cached entry to start of list
-            m_cacheList.splice(m_cacheList.begin(), m_cacheList, it->second);
-            _task.rawTileData = m_cacheList.front().second;
-
-            return true;
-        }
-
-        return false;
-    }
-    void put(const TileID& tileID, std::shared_ptr<std::vector<char>> rawDataRef) {
-
-        if (m_maxUsage <= 0) { return; }
-
-        std::lock_guard<std::mutex> lock(m_mutex);
-        TileID id(tileID.x, tileID.y, tileID.z);
-
-        m_cacheList.push_front({id, rawDataRef});
-        m_cacheMap[id] = m_cacheList.begin();
-
-        m_usage += rawDataRef->size();
-
-        while (m_usage > m_maxUsage) {
-            if (m_cacheList.empty()) {
-                LOGE("Error: invalid cache state!");
-                m_usage = 0;
-                break;
-            }
-
-            // LOGE("Limit raw cache tiles:%d, %fMB ", m_cacheList.size(),
-            //        double(m_cacheUsage) / (1024*1024));
-
-            auto& entry = m_cacheList.back();
-            m_usage -= entry.second->size();
-
-            m_cacheMap.erase(entry.first);
-            m_cacheList.pop_back();
-        }
-    }
-
-    void clear() {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_cacheMap.clear();
-        m_cacheList.clear();
-        m_usage = 0;
-    }
-};
-
 DataSource::DataSource(const std::string& _name, const std::string& _urlTemplate, int32_t _maxZoom) :
     m_name(_name), m_maxZoom(_maxZoom), m_urlTemplate(_urlTemplate),
-    m_cache(std::make_unique<RawCache>()){
+    m_cache(std::make_unique<RawCache>()),
+    m_tessellationCache(std::make_unique<TessellationCache>()),
+    m_diskCacheKey(DiskCache::sourceKey(_urlTemplate)) {
 
     static std::atomic<int32_t> s_serial;
 
@@ -98,7 +35,8 @@ DataSource::DataSource(const std::string& _name, const std::string& _urlTemplate
 }
 
 DataSource::~DataSource() {
-    clearData();
+    // Keep the tiles on disk for the next session
+    m_cache->clear();
 }
 
 std::shared_ptr<TileTask> DataSource::createTask(TileID _tileId, int _subTask) {
@@ -110,19 +48,90 @@ std::shared_ptr<TileTask> DataSource::createTask(TileID _tileId, int _subTask) {
 }
 
 void DataSource::setCacheSize(size_t _cacheSize) {
-    m_cache->m_maxUsage = _cacheSize;
+    m_cache->setMaxUsage(_cacheSize);
+}
+
+void DataSource::setTessellationCacheSize(size_t _cacheSize) {
+    m_tessellationCache->setMaxUsage(_cacheSize);
+}
+
+TessellationCache* DataSource::tessellationCache() const {
+    return m_tessellationCache->maxUsage() > 0 ? m_tessellationCache.get() : nullptr;
+}
+
+void DataSource::simplify(TileData& _tileData, const TileID& _tileID, const MapProjection& _projection) {
+
+    if (m_simplifyTolerance <= 0.f) { return; }
+
+    // Pixels covered by the tile, larger for overzoomed tiles
+    double tileSize = _projection.TileSize() * std::pow(2.0, _tileID.s - _tileID.z);
+
+    Simplifier simplifier(m_simplifyTolerance / tileSize);
+    SimplifyStats stats;
+    simplifier.simplify(_tileData, stats);
+
+    m_simplifiedPoints += stats.points;
+    m_removedPoints += stats.removed;
+}
+
+SimplifyStats DataSource::simplifyStats() const {
+    SimplifyStats stats;
+    stats.points = m_simplifiedPoints;
+    stats.removed = m_removedPoints;
+    return stats;
+}
+
+void DataSource::setDiskCache(std::shared_ptr<DiskCache> _diskCache) {
+    // Only downloaded tiles are cached
+    if (m_urlTemplate.empty()) { return; }
+
+    // Tiles are loaded and stored on other threads
+    std::atomic_store(&m_diskCache, _diskCache);
 }
 
 bool DataSource::cacheGet(DownloadTileTask& _task) {
-    return m_cache->get(_task);
+    return m_cache->get(_task.tileId(), _task.rawTileData);
 }
 
-void DataSource::cachePut(const TileID& _tileID, std::shared_ptr<std::vector<char>> _rawDataRef) {
-    m_cache->put(_tileID, _rawDataRef);
+bool DataSource::loadCachedTile(std::shared_ptr<TileTask>& _task, TileTaskCb _cb) {
+    auto diskCache = std::atomic_load(&m_diskCache);
+    if (!diskCache || !diskCache->contains(m_diskCacheKey, _task->tileId())) { return false; }
+
+    // Reading and verifying the record is left to the disk reader thread.
+    // Not added to the in-memory cache: the mapped record is kept in the
+    // page cache anyway and would be counted twice.
+    diskCache->load(m_diskCacheKey, _task->tileId(),
+            [this, _cb, task = std::move(_task)](RawBuffer&& rawData) mutable {
+                if (task->isCanceled()) { return; }
+
+                if (rawData.empty()) {
+                    // The record was evicted or is corrupt, download the tile
+                    auto copyTask = task;
+                    if (!this->loadTileData(std::move(task), _cb)) {
+                        _cb.func(std::move(copyTask));
+                    }
+                    return;
+                }
+
+                static_cast<DownloadTileTask&>(*task).rawTileData = std::move(rawData);
+                _cb.func(std::move(task));
+            });
+
+    return true;
+}
+
+void DataSource::cachePut(const TileID& _tileID, const RawBuffer& _rawData) {
+    m_cache->put(_tileID, _rawData);
+
+    if (auto diskCache = std::atomic_load(&m_diskCache)) {
+        diskCache->put(m_diskCacheKey, _tileID, _rawData);
+    }
 }
 
 void DataSource::clearData() {
     m_cache->clear();
+    m_tessellationCache->clear();
+    if (auto diskCache = std::atomic_load(&m_diskCache)) { diskCache->clear(m_diskCacheKey); }
     m_generation++;
 }
 
@@ -149,27 +158,33 @@ void DataSource::onTileLoaded(std::vector<char>&& _rawData, std::shared_ptr<Tile
 
     if (!_rawData.empty()) {
 
-        auto rawDataRef = std::make_shared<std::vector<char>>();
-        std::swap(*rawDataRef, _rawData);
+        RawBuffer rawData(std::move(_rawData));
 
         auto& task = static_cast<DownloadTileTask&>(*_task);
-        task.rawTileData = rawDataRef;
+        task.rawTileData = rawData;
 
         _cb.func(std::move(_task));
 
-        cachePut(tileID, rawDataRef);
+        cachePut(tileID, rawData);
     }
 }
 
 bool DataSource::loadTileData(std::shared_ptr<TileTask>&& _task, TileTaskCb _cb) {
 
+    if (loadCachedTile(_task, _cb)) { return true; }
+
     std::string url(constructURL(_task->tileId()));
 
     // lambda captured parameters are const by default, we want "task" (moved) to be non-const,
     // hence "mutable"
     // Refer: http://en.cppreference.com/w/cpp/language/lambda
+    // The request handle is released with the callback, also when the
+    // request gets canceled.
+    auto request = m_downloads.startRequest();
+
     return startUrlRequest(url,
-            [this, _cb, task = std::move(_task)](std::vector<char>&& rawData) mutable {
+            [this, _cb, request, task = std::move(_task)](std::vector<char>&& rawData, bool success) mutable {
+                request->finish(rawData.size(), success);
                 this->onTileLoaded(std::move(rawData), std::move(task), _cb);
             });
 
@@ -5,8 +5,11 @@
 #include <memory>
 #include <vector>
 
+#include "data/downloadBudget.h"
 #include "tile/tileTask.h"
 
+#include <atomic>
+
 namespace Tangram {
 
 class MapProjection;
@@ -15,7 +18,10 @@ struct TileID;
 struct Raster;
 class Tile;
 class TileManager;
-struct RawCache;
+class RawCache;
+class DiskCache;
+class TessellationCache;
+struct SimplifyStats;
 class Texture;
 
 class DataSource : public std::enable_shared_from_this<DataSource> {
@@ -66,6 +72,44 @@ public:
      */
     void setCacheSize(size_t _cacheSize);
 
+    /* @_cacheSize: Set size of the cache for polygon triangulations in bytes, 0 by default.
+     * Lets tile rebuilds, e.g. after scene updates, and styles drawing the same polygon
+     * reuse the triangles, see <TessellationCache>.
+     */
+    void setTessellationCacheSize(size_t _cacheSize);
+
+    /* The cache for polygon triangulations, nullptr when it is disabled */
+    TessellationCache* tessellationCache() const;
+
+    /* Simplify the lines and polygons of parsed tiles with a tolerance of @_pixels
+     * at the zoom level they are drawn at, 0 disables. See <Simplifier>.
+     */
+    void setSimplifyTolerance(float _pixels) { m_simplifyTolerance = _pixels; }
+    float simplifyTolerance() const { return m_simplifyTolerance; }
+
+    /* Simplifies the geometry of @_tileData, parsed for @_tileID */
+    void simplify(TileData& _tileData, const TileID& _tileID, const MapProjection& _projection);
+
+    /* Points of the simplified geometry and the number of removed points */
+    SimplifyStats simplifyStats() const;
+
+    /* Persistent cache for tile data, shared by all DataSources. Tiles that are
+     * not found in the in-memory cache are looked up there before downloading.
+     */
+    void setDiskCache(std::shared_ptr<DiskCache> _diskCache);
+
+    /* Limit of concurrent tile requests for this DataSource, see <DownloadBudget>.
+     * The limit is fixed unless setAdaptiveDownloads() was called.
+     */
+    void setMaxDownloads(size_t _maxDownloads) { m_downloads.setLimit(_maxDownloads); }
+    void setAdaptiveDownloads(size_t _min, size_t _max) { m_downloads.setAdaptive(_min, _max); }
+    size_t maxDownloads() const { return m_downloads.limit(); }
+
+    /* In-flight requests, queue wait time and throughput of tile downloads */
+    DownloadStats downloadStats() const { return m_downloads.stats(); }
+
+    DownloadBudget& downloadBudget() { return m_downloads; }
+
     /* ID of this DataSource instance */
     int32_t id() const { return m_id; }
 
@@ -98,9 +142,15 @@ protected:
         return url;
     }
 
+    /* Sets the raw data of @_task from the in-memory cache */
     bool cacheGet(DownloadTileTask& _task);
 
-    void cachePut(const TileID& _tileID, std::shared_ptr<std::vector<char>> _rawDataRef);
+    /* Starts reading @_task from the disk cache when it holds the tile, then
+     * takes over @_task and returns true. Tiles that turn out to be evicted
+     * or corrupt are downloaded */
+    bool loadCachedTile(std::shared_ptr<TileTask>& _task, TileTaskCb _cb);
+
+    void cachePut(const TileID& _tileID, const RawBuffer& _rawData);
 
     // This datasource is used to generate actual tile geometry
     bool m_generateGeometry = false;
@@ -122,6 +172,19 @@ protected:
 
     std::unique_ptr<RawCache> m_cache;
 
+    std::unique_ptr<TessellationCache> m_tessellationCache;
+
+    // Simplification tolerance in pixels
+    float m_simplifyTolerance = 0.f;
+    std::atomic<size_t> m_simplifiedPoints{0};
+    std::atomic<size_t> m_removedPoints{0};
+
+    std::shared_ptr<DiskCache> m_diskCache;
+    // Derived from the URL template, fixed so that other threads can read it
+    const uint64_t m_diskCacheKey;
+
+    DownloadBudget m_downloads;
+
     /* vector of raster sources (as raster samplers) referenced by this datasource */
     std::vector<std::shared_ptr<DataSource>> m_rasterSources;
 };
@@ -0,0 +1,492 @@
+#include "diskCache.h"
+#include "platform.h"
+#include "util/hash.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "util/asyncWorker.h"
+
+#define FILE_MAGIC 0x43444754 // "TGDC"
+#define FILE_VERSION 1
+#define RECORD_MAGIC 0x54524754 // "TGRT"
+#define RECORD_ALIGNMENT 16
+#define FILE_HEADER_SIZE 64
+// Larger tiles are not cached, they would evict too many others
+#define MAX_RECORD_FRACTION 8
+#define MIN_CAPACITY (256 * 1024)
+
+namespace Tangram {
+
+struct CacheFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;
+    // Records with a lower sequence number were evicted
+    uint64_t minSequence;
+    uint64_t reserved[5];
+};
+
+struct CacheRecord {
+    uint32_t magic;
+    // Checksum of the following header fields
+    uint32_t headerCheck;
+    uint64_t sequence;
+    uint64_t source;
+    int32_t x;
+    int32_t y;
+    // -1 marks a record that clears all older records of the source
+    int32_t z;
+    uint32_t size;
+    uint32_t dataCheck;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(CacheFileHeader) <= FILE_HEADER_SIZE, "File header too large");
+static_assert(FILE_HEADER_SIZE % RECORD_ALIGNMENT == 0, "Misaligned records");
+
+static uint32_t checksum(const char* _data, size_t _size, uint64_t _seed) {
+    uint64_t h = _seed ^ (_size * 0x9e3779b97f4a7c15ull);
+
+    // Word at a time, tiles are checked on each lookup
+    for (; _size >= 8; _data += 8, _size -= 8) {
+        uint64_t word;
+        std::memcpy(&word, _data, 8);
+        h = (h ^ word) * 0x100000001b3ull;
+        h ^= h >> 29;
+    }
+    for (; _size > 0; _data++, _size--) {
+        h = (h ^ uint8_t(*_data)) * 0x100000001b3ull;
+    }
+    h ^= h >> 32;
+
+    return uint32_t(h);
+}
+
+static uint32_t headerChecksum(const CacheRecord& _header) {
+    auto begin = reinterpret_cast<const char*>(&_header.sequence);
+    auto end = reinterpret_cast<const char*>(&_header + 1);
+    return checksum(begin, end - begin, _header.magic);
+}
+
+static uint64_t recordLength(uint32_t _size) {
+    uint64_t length = sizeof(CacheRecord) + _size;
+    return (length + RECORD_ALIGNMENT - 1) & ~uint64_t(RECORD_ALIGNMENT - 1);
+}
+
+size_t DiskCache::KeyHash::operator()(const Key& _key) const {
+    size_t seed = std::hash<uint64_t>()(_key.source);
+    hash_combine(seed, _key.x);
+    hash_combine(seed, _key.y);
+    hash_combine(seed, _key.z);
+    return seed;
+}
+
+uint64_t DiskCache::sourceKey(const std::string& _urlTemplate) {
+    // FNV-1a, std::hash is not guaranteed to be stable across runs
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (char c : _urlTemplate) {
+        h = (h ^ uint8_t(c)) * 0x100000001b3ull;
+    }
+    return h;
+}
+
+DiskCache::DiskCache(const std::string& _path, size_t _maxSize) {
+    m_capacity = _maxSize & ~size_t(RECORD_ALIGNMENT - 1);
+
+    if (m_capacity < MIN_CAPACITY) {
+        LOGE("Disk cache size too small: %d bytes", int(_maxSize));
+        return;
+    }
+
+    open(_path);
+
+    if (isOpen()) {
+        scan();
+        LOGD("Disk cache '%s': %d tiles, %fMB", _path.c_str(), int(m_index.size()),
+            double(m_usage) / (1024 * 1024));
+    }
+}
+
+DiskCache::~DiskCache() {
+    close();
+}
+
+void DiskCache::open(const std::string& _path) {
+    m_fd = ::open(_path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (m_fd < 0) {
+        LOGE("Cannot open disk cache '%s'", _path.c_str());
+        return;
+    }
+
+    // Records are not synchronized between processes
+    if (flock(m_fd, LOCK_EX | LOCK_NB) != 0) {
+        LOGE("Disk cache '%s' is used by another process", _path.c_str());
+        close();
+        return;
+    }
+
+    m_mappedSize = FILE_HEADER_SIZE + m_capacity;
+
+    CacheFileHeader header;
+    bool valid = pread(m_fd, &header, sizeof(header), 0) == sizeof(header) &&
+        header.magic == FILE_MAGIC &&
+        header.version == FILE_VERSION &&
+        header.capacity == m_capacity;
+
+    struct stat st;
+    if (fstat(m_fd, &st) != 0 || size_t(st.st_size) != m_mappedSize) {
+        valid = false;
+    }
+
+    if (!valid) {
+        // Truncating first drops all old records, the file is sparse until written
+        if (ftruncate(m_fd, 0) != 0 || ftruncate(m_fd, m_mappedSize) != 0) {
+            LOGE("Cannot resize disk cache '%s'", _path.c_str());
+            close();
+            return;
+        }
+    }
+
+    void* data = mmap(nullptr, m_mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (data == MAP_FAILED) {
+        LOGE("Cannot map disk cache '%s'", _path.c_str());
+        close();
+        return;
+    }
+    m_data = static_cast<char*>(data);
+
+    if (!valid) { reset(); }
+}
+
+void DiskCache::close() {
+    if (m_data) {
+        msync(m_data, m_mappedSize, MS_ASYNC);
+        munmap(m_data, m_mappedSize);
+        m_data = nullptr;
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+void DiskCache::detach() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_fd < 0) { return; }
+
+    if (m_data) { msync(m_data, m_mappedSize, MS_ASYNC); }
+
+    // The mapping keeps the file open, unlock it explicitly
+    flock(m_fd, LOCK_UN);
+    ::close(m_fd);
+    m_fd = -1;
+
+    m_index.clear();
+}
+
+char* DiskCache::records() {
+    return m_data + FILE_HEADER_SIZE;
+}
+
+static CacheFileHeader& fileHeader(char* _data) {
+    return *reinterpret_cast<CacheFileHeader*>(_data);
+}
+
+void DiskCache::reset() {
+    auto& header = fileHeader(m_data);
+    header.version = FILE_VERSION;
+    header.capacity = m_capacity;
+    header.minSequence = 0;
+    header.magic = FILE_MAGIC;
+}
+
+void DiskCache::scan() {
+    uint64_t minSequence = fileHeader(m_data).minSequence;
+    uint64_t maxSequence = 0;
+
+    std::unordered_map<uint64_t, uint64_t> cleared;
+
+    uint64_t offset = 0;
+    while (offset + sizeof(CacheRecord) <= m_capacity) {
+        auto& record = *reinterpret_cast<CacheRecord*>(records() + offset);
+        uint64_t length = recordLength(record.size);
+
+        if (record.magic != RECORD_MAGIC ||
+            record.headerCheck != headerChecksum(record) ||
+            length > m_capacity - offset) {
+            // Torn or overwritten record
+            offset += RECORD_ALIGNMENT;
+            continue;
+        }
+
+        if (record.sequence >= minSequence) {
+            Key key { record.source, record.x, record.y, record.z };
+            m_slots[offset] = { key, record.sequence, uint32_t(length) };
+            m_usage += length;
+
+            if (record.z < 0) {
+                auto& seq = cleared[record.source];
+                seq = std::max(seq, record.sequence);
+            }
+            if (record.sequence >= maxSequence) {
+                maxSequence = record.sequence;
+                m_head = offset + length;
+            }
+        }
+        offset += length;
+    }
+
+    for (auto& it : m_slots) {
+        auto& slot = it.second;
+        if (slot.key.z < 0) { continue; }
+
+        auto clear = cleared.find(slot.key.source);
+        if (clear != cleared.end() && slot.sequence < clear->second) { continue; }
+
+        auto entry = m_index.find(slot.key);
+        if (entry == m_index.end()) {
+            m_index.emplace(slot.key, it.first);
+        } else if (m_slots[entry->second].sequence < slot.sequence) {
+            entry->second = it.first;
+        }
+    }
+
+    m_nextSequence = std::max(maxSequence, minSequence) + 1;
+}
+
+void DiskCache::evict(uint64_t _begin, uint64_t _end) {
+    auto it = m_slots.lower_bound(_begin);
+    if (it != m_slots.begin()) {
+        auto prev = std::prev(it);
+        if (prev->first + prev->second.length > _begin) { it = prev; }
+    }
+
+    uint64_t minSequence = fileHeader(m_data).minSequence;
+
+    while (it != m_slots.end() && it->first < _end) {
+        auto& slot = it->second;
+
+        auto entry = m_index.find(slot.key);
+        if (entry != m_index.end() && entry->second == it->first) {
+            m_index.erase(entry);
+        }
+        minSequence = std::max(minSequence, slot.sequence + 1);
+        m_usage -= slot.length;
+
+        it = m_slots.erase(it);
+    }
+
+    // Best effort: nothing orders this store before the overwrites of the
+    // region reach the disk, so after a crash the header may still accept
+    // evicted records. Records torn by an overwrite fail their checksum.
+    fileHeader(m_data).minSequence = minSequence;
+}
+
+std::map<uint64_t, DiskCache::Pin>::iterator DiskCache::findPinned(uint64_t _begin, uint64_t _end) {
+    auto it = m_pinned.lower_bound(_begin);
+    if (it != m_pinned.begin()) {
+        auto prev = std::prev(it);
+        if (prev->first + prev->second.length > _begin) { return prev; }
+    }
+    if (it != m_pinned.end() && it->first < _end) { return it; }
+
+    return m_pinned.end();
+}
+
+bool DiskCache::append(const Key& _key, const char* _data, uint32_t _size, uint64_t& _offset) {
+    uint64_t length = recordLength(_size);
+
+    for (int wraps = 0;;) {
+        if (m_head + length > m_capacity) {
+            if (++wraps > 2) { return false; }
+
+            // Drop the remaining, oldest records and wrap around
+            evict(m_head, m_capacity);
+            m_head = 0;
+        }
+
+        auto pinned = findPinned(m_head, m_head + length);
+        if (pinned == m_pinned.end()) { break; }
+
+        // Records in front of and including the pinned one are evicted,
+        // but the pinned bytes stay untouched until they are released
+        uint64_t end = pinned->first + pinned->second.length;
+        evict(m_head, end);
+        m_head = end;
+    }
+    evict(m_head, m_head + length);
+
+    uint64_t offset = m_head;
+    auto& record = *reinterpret_cast<CacheRecord*>(records() + offset);
+
+    // Invalidate the record until it is completely written
+    record.magic = 0;
+
+    if (_size > 0) {
+        std::memcpy(records() + offset + sizeof(CacheRecord), _data, _size);
+    }
+
+    record.sequence = m_nextSequence++;
+    record.source = _key.source;
+    record.x = _key.x;
+    record.y = _key.y;
+    record.z = _key.z;
+    record.size = _size;
+    record.dataCheck = checksum(_data, _size, record.sequence);
+    record.reserved = 0;
+    record.headerCheck = headerChecksum({ RECORD_MAGIC, 0, record.sequence, record.source,
+                                          record.x, record.y, record.z, record.size,
+                                          record.dataCheck, record.reserved });
+    record.magic = RECORD_MAGIC;
+
+    m_slots[offset] = { _key, record.sequence, uint32_t(length) };
+    m_usage += length;
+    m_head += length;
+
+    _offset = offset;
+    return true;
+}
+
+bool DiskCache::contains(uint64_t _source, const TileID& _tileID) const {
+    if (!isOpen()) { return false; }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_index.find({ _source, _tileID.x, _tileID.y, _tileID.z }) != m_index.end();
+}
+
+bool DiskCache::get(uint64_t _source, const TileID& _tileID, RawBuffer& _data) {
+    if (!isOpen()) { return false; }
+
+    Key key { _source, _tileID.x, _tileID.y, _tileID.z };
+
+    RawBuffer buffer;
+    uint64_t offset;
+    uint64_t sequence;
+    uint32_t dataCheck;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto entry = m_index.find(key);
+        if (entry == m_index.end()) { return false; }
+
+        offset = entry->second;
+        auto& record = *reinterpret_cast<CacheRecord*>(records() + offset);
+        const char* data = records() + offset + sizeof(CacheRecord);
+
+        sequence = record.sequence;
+        dataCheck = record.dataCheck;
+
+        auto& pin = m_pinned[offset];
+        pin.length = m_slots[offset].length;
+        pin.count++;
+
+        // Releasing the buffer unpins the record
+        auto self = shared_from_this();
+        auto owner = std::shared_ptr<const void>(data, [self, offset](const void*) {
+            self->unpin(offset);
+        });
+
+        buffer = RawBuffer(std::move(owner), data, record.size);
+    }
+
+    // The pinned record is not overwritten, so the data is verified
+    // without blocking stores and lookups of other threads
+    if (dataCheck != checksum(buffer.data(), buffer.size(), sequence)) {
+        LOGW("Corrupt disk cache record for tile %s", _tileID.toString().c_str());
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto entry = m_index.find(key);
+        if (entry != m_index.end() && entry->second == offset) {
+            m_index.erase(entry);
+        }
+        return false;
+    }
+
+    // Outside of the lock, releasing a previous buffer unpins its record
+    _data = std::move(buffer);
+
+    return true;
+}
+
+void DiskCache::load(uint64_t _source, const TileID& _tileID, std::function<void(RawBuffer&&)> _cb) {
+    // Shared by all caches, so that a cache may be released on this thread
+    static AsyncWorker s_reader;
+
+    auto self = shared_from_this();
+    s_reader.enqueue([self, _source, _tileID, _cb]() {
+        RawBuffer data;
+        self->get(_source, _tileID, data);
+        _cb(std::move(data));
+    });
+}
+
+void DiskCache::unpin(uint64_t _offset) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_pinned.find(_offset);
+    if (it != m_pinned.end() && --it->second.count == 0) {
+        m_pinned.erase(it);
+    }
+}
+
+void DiskCache::put(uint64_t _source, const TileID& _tileID, const RawBuffer& _data) {
+    if (!isOpen() || _data.empty()) { return; }
+
+    if (recordLength(_data.size()) > m_capacity / MAX_RECORD_FRACTION) { return; }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_fd < 0) { return; }
+
+    Key key { _source, _tileID.x, _tileID.y, _tileID.z };
+
+    // A previous record of this tile becomes stale and is evicted in ring order
+    uint64_t offset;
+    if (append(key, _data.data(), _data.size(), offset)) {
+        m_index[key] = offset;
+    }
+}
+
+void DiskCache::clear(uint64_t _source) {
+    if (!isOpen()) { return; }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_fd < 0) { return; }
+
+    for (auto it = m_index.begin(); it != m_index.end();) {
+        if (it->first.source == _source) {
+            it = m_index.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Hides the older records of the source when the index is rebuilt
+    uint64_t offset;
+    if (!append({ _source, 0, 0, -1 }, nullptr, 0, offset)) {
+        LOGW("Disk cache is blocked, cleared tiles may reappear");
+    }
+}
+
+size_t DiskCache::usage() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_usage;
+}
+
+size_t DiskCache::count() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_index.size();
+}
+
+}
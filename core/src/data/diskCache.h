@@ -0,0 +1,150 @@
+#pragma once
+
+#include "tile/tileID.h"
+#include "util/rawBuffer.h"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Tangram {
+
+/* Persistent cache for raw tile data
+ *
+ * All tiles are stored in a single memory-mapped file that is used as a
+ * ring log: records are appended at the write head and the head wraps to
+ * the start of the file when it reaches the size limit, overwriting the
+ * oldest records. The index of (source, TileID) to record is kept in memory
+ * and rebuilt by scanning the record headers when the file is opened.
+ *
+ * Every record carries a sequence number and checksums of its header and
+ * data. Records that were torn by a crash fail their checksum and are
+ * ignored. The minimum sequence number of live records is persisted without
+ * syncing, so it only excludes records evicted before a crash on a best
+ * effort basis; such a record is still intact and holds older tile data.
+ *
+ * Lookups return the mapped record without copying. While such a buffer is
+ * referenced its record is pinned: the write head skips over it instead of
+ * overwriting it. DiskCache must be owned by a shared_ptr.
+ *
+ * Lookups and stores are thread-safe, stores typically run on network threads.
+ * get() reads and verifies the whole record, so the main thread only checks
+ * the index with contains() and leaves the read to load().
+ */
+class DiskCache : public std::enable_shared_from_this<DiskCache> {
+
+public:
+
+    /* Opens or creates the cache file at @_path with room for @_maxSize
+     * bytes of records. An existing file with a different size is reset. */
+    DiskCache(const std::string& _path, size_t _maxSize);
+
+    ~DiskCache();
+
+    bool isOpen() const { return m_data != nullptr; }
+
+    /* Closes the file, so that it can be opened again right away. Records
+     * that are still referenced stay mapped until the cache is destroyed,
+     * but are not pinned for a cache that opens the file again. Lookups and
+     * stores do nothing from now on */
+    void detach();
+
+    /* Stable key of a <DataSource>, derived from its URL template so that
+     * entries survive restarts and are shared by sources with the same URL */
+    static uint64_t sourceKey(const std::string& _urlTemplate);
+
+    /* Returns true when @_tileID is in the index, without touching the file */
+    bool contains(uint64_t _source, const TileID& _tileID) const;
+
+    /* Sets @_data to the mapped record of @_tileID, returns false when
+     * the tile is not cached or its record is corrupt */
+    bool get(uint64_t _source, const TileID& _tileID, RawBuffer& _data);
+
+    /* Runs get() on the disk reader thread and passes the record to @_cb,
+     * an empty buffer when the tile could not be read */
+    void load(uint64_t _source, const TileID& _tileID, std::function<void(RawBuffer&&)> _cb);
+
+    void put(uint64_t _source, const TileID& _tileID, const RawBuffer& _data);
+
+    /* Drops all tiles of @_source, also for future sessions */
+    void clear(uint64_t _source);
+
+    /* Bytes of the file that hold live records */
+    size_t usage() const;
+
+    size_t capacity() const { return m_capacity; }
+
+    /* Number of cached tiles */
+    size_t count() const;
+
+private:
+
+    struct Key {
+        uint64_t source;
+        int32_t x;
+        int32_t y;
+        int32_t z;
+
+        bool operator==(const Key& _other) const {
+            return source == _other.source && x == _other.x && y == _other.y && z == _other.z;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& _key) const;
+    };
+
+    // Record in the ring, also stale ones that still have to be evicted
+    struct Slot {
+        Key key;
+        uint64_t sequence;
+        uint32_t length;
+    };
+
+    void open(const std::string& _path);
+    void close();
+    void reset();
+    void scan();
+
+    struct Pin {
+        uint32_t length;
+        int count;
+    };
+
+    // Must be called with m_mutex locked. Returns false when no space
+    // could be found between pinned records
+    bool append(const Key& _key, const char* _data, uint32_t _size, uint64_t& _offset);
+    void evict(uint64_t _begin, uint64_t _end);
+    std::map<uint64_t, Pin>::iterator findPinned(uint64_t _begin, uint64_t _end);
+
+    void unpin(uint64_t _offset);
+
+    char* records();
+
+    mutable std::mutex m_mutex;
+
+    int m_fd = -1;
+    char* m_data = nullptr;
+    size_t m_mappedSize = 0;
+
+    // Size of the record area
+    size_t m_capacity = 0;
+
+    uint64_t m_head = 0;
+    uint64_t m_nextSequence = 1;
+    size_t m_usage = 0;
+
+    // Record offset of each cached tile
+    std::unordered_map<Key, uint64_t, KeyHash> m_index;
+    // All records by offset, in ring order
+    std::map<uint64_t, Slot> m_slots;
+    // Records referenced by buffers returned from get(), by offset
+    std::map<uint64_t, Pin> m_pinned;
+};
+
+}
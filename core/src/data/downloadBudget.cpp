@@ -0,0 +1,131 @@
+#include "downloadBudget.h"
+
+#include <algorithm>
+
+// Weight of a new sample in the moving averages
+#define STATS_SMOOTHING 0.1
+// Let the base latency recover slowly when the network got slower
+#define BASE_LATENCY_DRIFT 1.01
+
+namespace Tangram {
+
+constexpr size_t DownloadBudget::DEFAULT_LIMIT;
+constexpr size_t DownloadBudget::MAX_ADAPTIVE_LIMIT;
+constexpr double DownloadBudget::CONGESTION_FACTOR;
+
+static double smooth(double _average, double _sample, size_t _count) {
+    if (_count <= 1) { return _sample; }
+    return _average + (_sample - _average) * STATS_SMOOTHING;
+}
+
+DownloadBudget::Request::Request(DownloadBudget& _budget)
+    : m_budget(_budget),
+      m_start(Clock::now()) {
+    m_budget.m_inFlight++;
+}
+
+DownloadBudget::Request::~Request() {
+    m_budget.m_inFlight--;
+}
+
+void DownloadBudget::Request::finish(size_t _bytes, bool _success) {
+    if (m_finished) { return; }
+    m_finished = true;
+
+    m_budget.onFinished(m_start, _bytes, _success);
+}
+
+DownloadBudget::DownloadBudget(size_t _limit)
+    : m_limit(std::max<size_t>(_limit, 1)),
+      m_inFlight(0),
+      m_adaptive(false),
+      m_window(m_limit) {}
+
+void DownloadBudget::setLimit(size_t _limit) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_adaptive = false;
+    m_limit = std::max<size_t>(_limit, 1);
+    m_window = m_limit;
+}
+
+void DownloadBudget::setAdaptive(size_t _minLimit, size_t _maxLimit) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_minLimit = std::max<size_t>(_minLimit, 1);
+    m_maxLimit = std::max(_maxLimit, m_minLimit);
+    m_adaptive = true;
+
+    m_window = std::min(std::max(m_window, double(m_minLimit)), double(m_maxLimit));
+    m_limit = size_t(m_window);
+}
+
+std::shared_ptr<DownloadBudget::Request> DownloadBudget::startRequest() {
+    return std::make_shared<Request>(*this);
+}
+
+void DownloadBudget::addQueueWait(Clock::duration _wait) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    double ms = std::chrono::duration<double, std::milli>(_wait).count();
+    m_queueWait = smooth(m_queueWait, ms, ++m_queueWaitCount);
+}
+
+void DownloadBudget::onFinished(Clock::time_point _start, size_t _bytes, bool _success) {
+    auto now = Clock::now();
+    double ms = std::chrono::duration<double, std::milli>(now - _start).count();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_completed++;
+    bool failed = !_success;
+
+    if (failed) {
+        m_failed++;
+    } else {
+        m_latency = smooth(m_latency, ms, m_completed - m_failed);
+        if (ms > 0) {
+            m_bytesPerSecond = smooth(m_bytesPerSecond, _bytes * 1000.0 / ms, m_completed - m_failed);
+        }
+        if (m_baseLatency == 0 || ms < m_baseLatency) {
+            m_baseLatency = ms;
+        } else {
+            m_baseLatency *= BASE_LATENCY_DRIFT;
+        }
+    }
+
+    if (!m_adaptive) { return; }
+
+    bool congested = failed || ms > m_baseLatency * CONGESTION_FACTOR;
+
+    if (congested) {
+        // Multiplicative decrease, once per round trip: only requests
+        // that started after the last decrease reflect the new limit.
+        if (_start > m_lastDecrease) {
+            m_window = std::max(m_window * 0.5, double(m_minLimit));
+            m_lastDecrease = now;
+        }
+    } else if (m_inFlight >= m_limit) {
+        // Additive increase while the limit is saturated
+        m_window = std::min(m_window + 1.0 / m_window, double(m_maxLimit));
+    }
+
+    m_limit = size_t(m_window);
+}
+
+DownloadStats DownloadBudget::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    DownloadStats stats;
+    stats.limit = m_limit;
+    stats.inFlight = m_inFlight;
+    stats.completed = m_completed;
+    stats.failed = m_failed;
+    stats.latency = m_latency;
+    stats.queueWait = m_queueWait;
+    stats.bytesPerSecond = m_bytesPerSecond;
+
+    return stats;
+}
+
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+namespace Tangram {
+
+struct DownloadStats {
+    // Current limit of concurrent requests
+    size_t limit = 0;
+    // Requests that were started and are not finished or canceled yet
+    size_t inFlight = 0;
+    // Finished requests, including failed ones
+    size_t completed = 0;
+    size_t failed = 0;
+    // Moving averages in milliseconds
+    double latency = 0;
+    double queueWait = 0;
+    // Moving average of received bytes per second over the request latency
+    double bytesPerSecond = 0;
+};
+
+/* Limits the number of concurrent tile downloads of a <DataSource>
+ *
+ * The limit is either fixed or adapted to the observed request latency,
+ * similar to AIMD congestion control: while requests saturate the limit and
+ * return within CONGESTION_FACTOR times the lowest observed latency, the
+ * limit grows by one per limit-many completions. A slow or failed request
+ * halves the limit, at most once per round trip.
+ *
+ * Request callbacks run on network threads, all methods are thread-safe.
+ */
+class DownloadBudget {
+
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t DEFAULT_LIMIT = 4;
+    static constexpr size_t MAX_ADAPTIVE_LIMIT = 32;
+    static constexpr double CONGESTION_FACTOR = 2.0;
+
+    /* Handle of a started request. Destroying it without finish(),
+     * e.g. when the request was canceled, only releases the in-flight slot */
+    class Request {
+    public:
+        Request(DownloadBudget& _budget);
+        ~Request();
+
+        /* @_success is false when the request failed. Empty responses,
+         * e.g. of empty tiles, may succeed */
+        void finish(size_t _bytes, bool _success);
+
+    private:
+        DownloadBudget& m_budget;
+        Clock::time_point m_start;
+        bool m_finished = false;
+    };
+
+    DownloadBudget(size_t _limit = DEFAULT_LIMIT);
+
+    /* Set a fixed limit, disables adaptation */
+    void setLimit(size_t _limit);
+
+    /* Adapt the limit between @_minLimit and @_maxLimit */
+    void setAdaptive(size_t _minLimit, size_t _maxLimit = MAX_ADAPTIVE_LIMIT);
+
+    bool isAdaptive() const { return m_adaptive; }
+
+    size_t limit() const { return m_limit; }
+
+    size_t inFlight() const { return m_inFlight; }
+
+    /* Must be kept alive, e.g. in the request callback, until the request
+     * finished or was canceled */
+    std::shared_ptr<Request> startRequest();
+
+    /* Time a tile waited for a free download slot */
+    void addQueueWait(Clock::duration _wait);
+
+    DownloadStats stats() const;
+
+private:
+
+    void onFinished(Clock::time_point _start, size_t _bytes, bool _success);
+
+    mutable std::mutex m_mutex;
+
+    std::atomic<size_t> m_limit;
+    std::atomic<size_t> m_inFlight;
+    std::atomic<bool> m_adaptive;
+
+    // Fractional limit used by additive increase
+    double m_window;
+    size_t m_minLimit = 1;
+    size_t m_maxLimit = MAX_ADAPTIVE_LIMIT;
+
+    // Lowest observed latency in milliseconds, 0 when unknown
+    double m_baseLatency = 0;
+    // Requests started before this point cannot trigger another decrease
+    Clock::time_point m_lastDecrease;
+
+    size_t m_completed = 0;
+    size_t m_failed = 0;
+    double m_latency = 0;
+    size_t m_queueWaitCount = 0;
+    double m_queueWait = 0;
+    double m_bytesPerSecond = 0;
+};
+
+}
@@ -24,7 +24,7 @@ std::shared_ptr<TileData> GeoJsonSource::parse(const TileTask& _task,
     // Parse data into a JSON document
     const char* error;
     size_t offset;
-    auto document = JsonParseBytes(task.rawTileData->data(), task.rawTileData->size(), &error, &offset);
+    auto document = JsonParseBytes(task.rawTileData.data(), task.rawTileData.size(), &error, &offset);
 
     if (error) {
         LOGE("Json parsing failed on tile [%s]: %s (%u)", task.tileId().toString().c_str(), error, offset);
@@ -46,11 +46,14 @@ std::shared_ptr<TileData> GeoJsonSource::parse(const TileTask& _task,
 
     // Transform JSON data into TileData using GeoJson functions
     if (GeoJson::isFeatureCollection(document)) {
-        tileData->layers.push_back(GeoJson::getLayer(document, projFn, m_id));
+        tileData->layers.push_back(GeoJson::getLayer(document, projFn, m_id, tileData->arena.get()));
     } else {
         for (auto layer = document.MemberBegin(); layer != document.MemberEnd(); ++layer) {
+            if (_task.isCanceled()) { return nullptr; }
+
             if (GeoJson::isFeatureCollection(layer->value)) {
-                tileData->layers.push_back(GeoJson::getLayer(layer->value, projFn, m_id));
+                tileData->layers.push_back(GeoJson::getLayer(layer->value, projFn, m_id,
+                                                             tileData->arena.get()));
                 tileData->layers.back().name = layer->name.GetString();
             }
         }
@@ -4,6 +4,7 @@
 #include "tile/tileID.h"
 #include "tile/tile.h"
 #include "tile/tileTask.h"
+#include "scene/decodePlan.h"
 #include "util/pbfParser.h"
 #include "platform.h"
 
@@ -20,12 +21,21 @@ std::shared_ptr<TileData> MVTSource::parse(const TileTask& _task, const MapProje
 
     auto& task = static_cast<const DownloadTileTask&>(_task);
 
-    protobuf::message item(task.rawTileData->data(), task.rawTileData->size());
-    PbfParser::ParserContext ctx(m_id);
+    protobuf::message item(task.rawTileData.data(), task.rawTileData.size());
+
+    // Skip the layers and properties that the scene does not read
+    const DecodePlan* plan = _task.decodePlan();
+    PbfParser::ParserContext ctx(m_id, plan, tileData->arena.get());
 
     while(item.next()) {
+        if (_task.isCanceled()) { return nullptr; }
+
         if(item.tag == 3) {
-            tileData->layers.push_back(PbfParser::getLayer(ctx, item.getMessage()));
+            auto layerMsg = item.getMessage();
+
+            if (plan && !plan->hasLayer(PbfParser::getLayerName(layerMsg))) { continue; }
+
+            tileData->layers.push_back(PbfParser::getLayer(ctx, layerMsg));
         } else {
             item.skip();
         }
@@ -23,7 +23,7 @@ const Value& Properties::get(const std::string& key) const {
 
     const auto it = std::find_if(props.begin(), props.end(),
                                  [&](const auto& item) {
-                                     return item.key == key;
+                                     return item.key.str() == key;
                                  });
     if (it == props.end()) {
         return NOT_FOUND;
@@ -33,19 +33,32 @@ const Value& Properties::get(const std::string& key) const {
     //                            [](auto& item, auto& key) {
     //                                return keyComparator(item.key, key);
     //                            });
-    // if (it == props.end() || it->key != key) {
+    // if (it == props.end() || it->key.str() != key) {
     //     return NOT_FOUND;
     // }
 
     return it->value;
 }
 
+const Value& Properties::get(Atom key) const {
+    const static Value NOT_FOUND(none_type{});
+
+    for (const auto& item : props) {
+        if (item.key == key) { return item.value; }
+    }
+    return NOT_FOUND;
+}
+
 void Properties::clear() { props.clear(); }
 
 bool Properties::contains(const std::string& key) const {
     return !get(key).is<none_type>();
 }
 
+bool Properties::contains(Atom key) const {
+    return !get(key).is<none_type>();
+}
+
 bool Properties::getNumber(const std::string& key, double& value) const {
     auto& it = get(key);
     if (it.is<double>()) {
@@ -55,6 +68,15 @@ bool Properties::getNumber(const std::string& key, double& value) const {
     return false;
 }
 
+bool Properties::getNumber(Atom key, double& value) const {
+    auto& it = get(key);
+    if (it.is<double>()) {
+        value = it.get<double>();
+        return true;
+    }
+    return false;
+}
+
 double Properties::getNumber(const std::string& key) const {
     auto& it = get(key);
     if (it.is<double>()) {
@@ -82,6 +104,16 @@ const std::string& Properties::getString(const std::string& key) const {
     return EMPTY_STRING;
 }
 
+const std::string& Properties::getString(Atom key) const {
+    const static std::string EMPTY_STRING = "";
+
+    auto& it = get(key);
+    if (it.is<std::string>()) {
+        return it.get<std::string>();
+    }
+    return EMPTY_STRING;
+}
+
 const bool Properties::getAsString(const std::string& key, std::string& value) const {
     auto& it = get(key);
 
@@ -119,10 +151,10 @@ void Properties::set(std::string key, std::string value) {
 
     auto it = std::lower_bound(props.begin(), props.end(), key,
                                [](auto& item, auto& key) {
-                                   return keyComparator(item.key, key);
+                                   return keyComparator(item.key.str(), key);
                                });
 
-    if (it == props.end() || it->key != key) {
+    if (it == props.end() || it->key.str() != key) {
         props.emplace(it, std::move(key), std::move(value));
     } else {
         it->value = std::move(value);
@@ -133,10 +165,10 @@ void Properties::set(std::string key, double value) {
 
     auto it = std::lower_bound(props.begin(), props.end(), key,
                                [](auto& item, auto& key) {
-                                   return keyComparator(item.key, key);
+                                   return keyComparator(item.key.str(), key);
                                });
 
-    if (it == props.end() || it->key != key) {
+    if (it == props.end() || it->key.str() != key) {
         props.emplace(it, std::move(key), value);
     } else {
         it->value = value;
@@ -149,7 +181,7 @@ std::string Properties::toJson() const {
 
     for (const auto& item : props) {
         bool last = (&item == &props.back());
-        json += "\"" + item.key + "\": \"" + asString(item.value) + (last ? "\"" : "\",");
+        json += "\"" + item.key.str() + "\": \"" + asString(item.value) + (last ? "\"" : "\",");
     }
 
     json += " }";
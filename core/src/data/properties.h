@@ -1,5 +1,7 @@
 #pragma once
 
+#include "util/atom.h"
+
 #include <vector>
 #include <string>
 
@@ -22,20 +24,29 @@ struct Properties {
 
     const Value& get(const std::string& key) const;
 
+    /* Lookup by interned key, comparing keys by pointer */
+    const Value& get(Atom key) const;
+
     void sort();
 
     void clear();
 
     bool contains(const std::string& key) const;
 
+    bool contains(Atom key) const;
+
     bool getNumber(const std::string& key, double& value) const;
 
+    bool getNumber(Atom key, double& value) const;
+
     double getNumber(const std::string& key) const;
 
     bool getString(const std::string& key, std::string& value) const;
 
     const std::string& getString(const std::string& key) const;
 
+    const std::string& getString(Atom key) const;
+
     std::string asString(const Value& value) const;
 
     std::string getAsString(const std::string& key) const;
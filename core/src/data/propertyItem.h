@@ -1,19 +1,25 @@
 #pragma once
 
+#include "util/atom.h"
 #include "util/variant.h"
 
 namespace Tangram {
 
 struct PropertyItem {
-    PropertyItem(std::string _key, Value _value) :
-        key(std::move(_key)), value(std::move(_value)) {}
+    PropertyItem(Atom _key, Value _value) :
+        key(_key), value(std::move(_value)) {}
 
-    std::string key;
+    PropertyItem(const std::string& _key, Value _value) :
+        key(Atom::intern(_key)), value(std::move(_value)) {}
+
+    Atom key;
     Value value;
     bool operator<(const PropertyItem& _rhs) const {
-        return key.size() == _rhs.key.size()
-            ? key < _rhs.key
-            : key.size() < _rhs.key.size();
+        const auto& a = key.str();
+        const auto& b = _rhs.key.str();
+        return a.size() == b.size()
+            ? a < b
+            : a.size() < b.size();
     }
 };
 
@@ -35,7 +35,7 @@ public:
 
         if (!m_texture) {
             // Decode texture data
-            m_texture = source->createTexture(*rawTileData);
+            m_texture = source->createTexture(rawTileData);
         }
 
         // Create tile geometries
@@ -76,7 +76,7 @@ RasterSource::RasterSource(const std::string& _name, const std::string& _urlTemp
     m_emptyTexture = std::make_shared<Texture>(nullptr, 0, m_texOptions, m_genMipmap, true);
 }
 
-std::shared_ptr<Texture> RasterSource::createTexture(const std::vector<char>& _rawTileData) {
+std::shared_ptr<Texture> RasterSource::createTexture(const RawBuffer& _rawTileData) {
     auto udata = reinterpret_cast<const unsigned char*>(_rawTileData.data());
     size_t dataSize = _rawTileData.size();
 
@@ -137,19 +137,20 @@ void RasterSource::onTileLoaded(std::vector<char>&& _rawData, std::shared_ptr<Ti
 
     TileID tileID = _task->tileId();
 
-    auto rawDataRef = std::make_shared<std::vector<char>>();
-    std::swap(*rawDataRef, _rawData);
+    RawBuffer rawData(std::move(_rawData));
 
     auto& task = static_cast<DownloadTileTask&>(*_task);
-    task.rawTileData = rawDataRef;
+    task.rawTileData = rawData;
 
     _cb.func(std::move(_task));
 
-    cachePut(tileID, rawDataRef);
+    cachePut(tileID, rawData);
 }
 
 bool RasterSource::loadTileData(std::shared_ptr<TileTask>&& _task, TileTaskCb _cb) {
 
+    if (loadCachedTile(_task, _cb)) { return true; }
+
     std::string url(constructURL(_task->tileId()));
 
     auto copyTask = _task;
@@ -157,8 +158,11 @@ bool RasterSource::loadTileData(std::shared_ptr<TileTask>&& _task, TileTaskCb _c
     // lambda captured parameters are const by default, we want "task" (moved) to be non-const,
     // hence "mutable"
     // Refer: http://en.cppreference.com/w/cpp/language/lambda
+    auto request = m_downloads.startRequest();
+
     bool status = startUrlRequest(url,
-            [this, _cb, task = std::move(_task)](std::vector<char>&& rawData) mutable {
+            [this, _cb, request, task = std::move(_task)](std::vector<char>&& rawData, bool success) mutable {
+                request->finish(rawData.size(), success);
                 this->onTileLoaded(std::move(rawData), std::move(task), _cb);
             });
 
@@ -45,7 +45,7 @@ public:
     virtual void clearRaster(const TileID& id) override;
     virtual bool isRaster() const override { return true; }
 
-    std::shared_ptr<Texture> createTexture(const std::vector<char>& _rawTileData);
+    std::shared_ptr<Texture> createTexture(const RawBuffer& _rawTileData);
 
     Raster getRaster(const TileTask& _task);
 
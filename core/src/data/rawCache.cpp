@@ -0,0 +1,99 @@
+#include "rawCache.h"
+
+namespace Tangram {
+
+constexpr size_t RawCache::NUM_SHARDS;
+
+void RawCache::setMaxUsage(size_t _maxUsage) {
+    m_maxUsage = _maxUsage;
+}
+
+RawCache::Shard& RawCache::shard(const TileID& _tileID) {
+    return m_shards[std::hash<TileID>()(_tileID) % NUM_SHARDS];
+}
+
+void RawCache::evictLast(Shard& _shard, CacheList& _evicted) {
+    auto& entry = _shard.list.back();
+    _shard.usage -= entry.second.size();
+    m_usage -= entry.second.size();
+
+    _shard.map.erase(entry.first);
+    _evicted.splice(_evicted.end(), _shard.list, std::prev(_shard.list.end()));
+}
+
+bool RawCache::get(const TileID& _tileID, RawBuffer& _data) {
+
+    if (m_maxUsage == 0) { return false; }
+
+    TileID id(_tileID.x, _tileID.y, _tileID.z);
+    auto& shard = this->shard(id);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.map.find(id);
+    if (it == shard.map.end()) { return false; }
+
+    // Move cached entry to start of list
+    shard.list.splice(shard.list.begin(), shard.list, it->second);
+    _data = shard.list.front().second;
+
+    return true;
+}
+
+void RawCache::put(const TileID& _tileID, const RawBuffer& _data) {
+
+    size_t maxUsage = m_maxUsage;
+    if (maxUsage == 0 || _data.size() > maxUsage) { return; }
+
+    TileID id(_tileID.x, _tileID.y, _tileID.z);
+    auto& shard = this->shard(id);
+
+    // Evicted buffers are released after the locks
+    CacheList evicted;
+
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.map.find(id);
+        if (it != shard.map.end()) {
+            shard.usage -= it->second->second.size();
+            m_usage -= it->second->second.size();
+            evicted.splice(evicted.end(), shard.list, it->second);
+        }
+
+        shard.list.emplace_front(id, _data);
+        shard.map[id] = shard.list.begin();
+        shard.usage += _data.size();
+        m_usage += _data.size();
+
+        // Keep the new tile
+        while (m_usage > maxUsage && shard.list.size() > 1) {
+            evictLast(shard, evicted);
+        }
+    }
+
+    // Only one shard is locked at a time
+    for (size_t i = 0; i < NUM_SHARDS && m_usage > maxUsage; i++) {
+        auto& other = m_shards[m_evictShard++ % NUM_SHARDS];
+        if (&other == &shard) { continue; }
+
+        std::lock_guard<std::mutex> lock(other.mutex);
+        while (m_usage > maxUsage && !other.list.empty()) {
+            evictLast(other, evicted);
+        }
+    }
+}
+
+void RawCache::clear() {
+    for (auto& shard : m_shards) {
+        CacheList evicted;
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.map.clear();
+        evicted.swap(shard.list);
+        m_usage -= shard.usage;
+        shard.usage = 0;
+    }
+}
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "tile/tileHash.h"
+#include "tile/tileID.h"
+#include "util/rawBuffer.h"
+
+#include <array>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace Tangram {
+
+/* In-memory LRU cache for raw tile data of a <DataSource>
+ *
+ * Lookups run on the main thread when tasks are created, stores on network
+ * threads. To keep them from contending for a single lock, tiles are
+ * distributed over NUM_SHARDS LRU lists by the hash of their TileID. The
+ * byte budget is shared: a store that exceeds it evicts the least recently
+ * used tiles of its own shard first, then those of the other shards, so a
+ * single tile may use up to the whole budget.
+ */
+class RawCache {
+
+public:
+
+    static constexpr size_t NUM_SHARDS = 16;
+
+    /* Limit of cached bytes, 0 disables the cache */
+    void setMaxUsage(size_t _maxUsage);
+
+    size_t maxUsage() const { return m_maxUsage; }
+
+    size_t usage() const { return m_usage; }
+
+    bool get(const TileID& _tileID, RawBuffer& _data);
+
+    void put(const TileID& _tileID, const RawBuffer& _data);
+
+    void clear();
+
+private:
+
+    using CacheEntry = std::pair<TileID, RawBuffer>;
+    using CacheList = std::list<CacheEntry>;
+    using CacheMap = std::unordered_map<TileID, typename CacheList::iterator>;
+
+    struct Shard {
+        mutable std::mutex mutex;
+        CacheMap map;
+        CacheList list;
+        size_t usage = 0;
+    };
+
+    Shard& shard(const TileID& _tileID);
+
+    /* Moves the least recently used tile of the locked @_shard to @_evicted */
+    void evictLast(Shard& _shard, CacheList& _evicted);
+
+    std::array<Shard, NUM_SHARDS> m_shards;
+
+    std::atomic<size_t> m_maxUsage{0};
+    std::atomic<size_t> m_usage{0};
+
+    // Next shard to evict from when the own shard of a store is not enough
+    std::atomic<size_t> m_evictShard{0};
+};
+
+}
@@ -2,6 +2,7 @@
 
 #include "glm/vec3.hpp"
 #include "data/properties.h"
+#include "util/arena.h"
 
 #include <vector>
 #include <string>
@@ -53,6 +54,14 @@ Data heirarchy:
   A <Point> is 3 32-bit floating point coordinates representing x, y, and z
   (in that order).
 
+Memory:
+
+  The geometry containers of a <TileData> are allocated from its <Arena>:
+  coordinates of consecutive features are laid out contiguously in a few
+  large blocks, which are freed at once with the TileData. Parsers pass
+  the arena to every geometry container they create. Containers created
+  without an arena use the heap.
+
 */
 namespace Tangram {
 
@@ -65,19 +74,22 @@ enum GeometryType {
 
 typedef glm::vec3 Point;
 
-typedef std::vector<Point> Line;
+typedef std::vector<Point, ArenaAllocator<Point>> Line;
 
-typedef std::vector<Line> Polygon;
+typedef std::vector<Line, ArenaAllocator<Line>> Polygon;
 
 struct Feature {
     Feature() {}
-    Feature(int32_t _sourceId) { props.sourceId = _sourceId; }
+    Feature(int32_t _sourceId, Arena* _arena = nullptr)
+        : points(_arena), lines(_arena), polygons(_arena) {
+        props.sourceId = _sourceId;
+    }
 
     GeometryType geometryType = GeometryType::polygons;
 
-    std::vector<Point> points;
-    std::vector<Line> lines;
-    std::vector<Polygon> polygons;
+    std::vector<Point, ArenaAllocator<Point>> points;
+    std::vector<Line, ArenaAllocator<Line>> lines;
+    std::vector<Polygon, ArenaAllocator<Polygon>> polygons;
 
     Properties props;
 };
@@ -94,6 +106,11 @@ struct Layer {
 
 struct TileData {
 
+    TileData() : arena(std::make_unique<Arena>()) {}
+
+    // Memory of the feature geometry, declared first to be freed last
+    std::unique_ptr<Arena> arena;
+
     std::vector<Layer> layers;
 
 };
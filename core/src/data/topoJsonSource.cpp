@@ -24,7 +24,7 @@ std::shared_ptr<TileData> TopoJsonSource::parse(const TileTask& _task,
     // Parse data into a JSON document
     const char* error;
     size_t offset;
-    auto document = JsonParseBytes(task.rawTileData->data(), task.rawTileData->size(), &error, &offset);
+    auto document = JsonParseBytes(task.rawTileData.data(), task.rawTileData.size(), &error, &offset);
 
     if (error) {
         LOGE("Json parsing failed on tile [%s]: %s (%u)", task.tileId().toString().c_str(), error, offset);
@@ -53,7 +53,9 @@ std::shared_ptr<TileData> TopoJsonSource::parse(const TileTask& _task,
     if (objectsIt == document.MemberEnd()) { return tileData; }
     auto& objects = objectsIt->value;
     for (auto layer = objects.MemberBegin(); layer != objects.MemberEnd(); ++layer) {
-        tileData->layers.push_back(TopoJson::getLayer(layer, topology, m_id));
+        if (_task.isCanceled()) { return nullptr; }
+
+        tileData->layers.push_back(TopoJson::getLayer(layer, topology, m_id, tileData->arena.get()));
     }
 
     // Discard JSON object and return TileData
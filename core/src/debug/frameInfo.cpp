@@ -2,9 +2,13 @@
 
 #include "tangram.h"
 #include "debug/textDisplay.h"
+#include "scene/scene.h"
+#include "style/style.h"
 #include "tile/tileManager.h"
 #include "tile/tile.h"
 #include "tile/tileCache.h"
+#include "tile/tileWorker.h"
+#include "util/simplify.h"
 #include "gl/primitives.h"
 #include "view/view.h"
 #include "gl.h"
@@ -52,7 +56,8 @@ void FrameInfo::beginFrame() {
 }
 
 
-void FrameInfo::draw(const View& _view, TileManager& _tileManager) {
+void FrameInfo::draw(const View& _view, const Scene& _scene, TileManager& _tileManager,
+                     const TileWorker& _tileWorker) {
 
     if (getDebugFlag(DebugFlags::tangram_infos) || getDebugFlag(DebugFlags::tangram_stats)) {
         static int cpt = 0;
@@ -100,10 +105,7 @@ void FrameInfo::draw(const View& _view, TileManager& _tileManager) {
         avgTimeCpu /= 60;
         avgTimeUpdate /= 60;
 
-        size_t memused = 0;
-        for (const auto& tile : _tileManager.getVisibleTiles()) {
-            memused += tile->getMemoryUsage();
-        }
+        const auto& memused = _tileManager.getVisibleMemoryUsage();
 
         if (getDebugFlag(DebugFlags::tangram_infos)) {
             std::vector<std::string> debuginfos;
@@ -112,7 +114,39 @@ void FrameInfo::draw(const View& _view, TileManager& _tileManager) {
                                  + std::to_string(_tileManager.getVisibleTiles().size()));
             debuginfos.push_back("tile cache size:"
                                  + std::to_string(_tileManager.getTileCache()->getMemoryUsage() / 1024) + "kb");
-            debuginfos.push_back("tile size:" + std::to_string(memused / 1024) + "kb");
+            auto cacheStats = _tileManager.getTileCache()->getTotalStats();
+            debuginfos.push_back("tile cache hits:"
+                                 + to_string_with_precision(cacheStats.hitRatio() * 100, 1) + "%");
+            debuginfos.push_back("tile size:" + std::to_string(memused.total() / 1024) + "kb"
+                                 + " gpu:" + std::to_string((memused.gpuBuffers + memused.gpuTextures) / 1024) + "kb"
+                                 + " cpu:" + std::to_string((memused.cpuBuffers + memused.cpuTextures) / 1024) + "kb"
+                                 + " labels:" + std::to_string(memused.labels / 1024) + "kb");
+            for (const auto& tileSet : _tileManager.getTileSets()) {
+                auto stats = tileSet.source->downloadStats();
+                debuginfos.push_back(tileSet.source->name() + " downloads:"
+                                     + std::to_string(stats.inFlight) + "/" + std::to_string(stats.limit)
+                                     + " wait:" + to_string_with_precision(stats.queueWait, 1) + "ms"
+                                     + " " + std::to_string(size_t(stats.bytesPerSecond / 1024)) + "kb/s");
+
+                if (tileSet.source->simplifyTolerance() > 0.f) {
+                    auto simplified = tileSet.source->simplifyStats();
+                    debuginfos.push_back(tileSet.source->name() + " simplified:"
+                                         + std::to_string(simplified.removed) + "/"
+                                         + std::to_string(simplified.points) + " points");
+                }
+            }
+            // Vertices of labels, uploaded each frame
+            std::string labelVertices = "label vertices:";
+            for (const auto& style : _scene.styles()) {
+                size_t size = style->dynamicMeshSize();
+                if (size == 0) { continue; }
+                labelVertices += " " + style->getName() + ":" + std::to_string(size / 1024) + "kb";
+            }
+            debuginfos.push_back(labelVertices);
+            auto buildStats = _tileWorker.buildStats();
+            debuginfos.push_back("tile builds:" + std::to_string(buildStats.built)
+                                 + " canceled:" + std::to_string(buildStats.canceled)
+                                 + " saved:" + std::to_string(size_t(buildStats.savedTime())) + "ms");
             debuginfos.push_back("avg frame cpu time:" + to_string_with_precision(avgTimeCpu, 2) + "ms");
             debuginfos.push_back("avg frame render time:" + to_string_with_precision(avgTimeRender, 2) + "ms");
             debuginfos.push_back("avg frame update time:" + to_string_with_precision(avgTimeUpdate, 2) + "ms");
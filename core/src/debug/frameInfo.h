@@ -2,7 +2,9 @@
 
 namespace Tangram {
 
+class Scene;
 class TileManager;
+class TileWorker;
 class View;
 
 struct FrameInfo {
@@ -12,7 +14,8 @@ struct FrameInfo {
 
     static void endUpdate();
 
-    static void draw(const View& _view, TileManager& _tileManager);
+    static void draw(const View& _view, const Scene& _scene, TileManager& _tileManager,
+                     const TileWorker& _tileWorker);
 };
 
 }
@@ -47,6 +47,11 @@ public:
         return MeshBase::bufferSize();
     }
 
+    void addMemoryUsage(MemoryUsage& _usage) const override {
+        if (m_isUploaded) { _usage.gpuBuffers += bufferSize(); }
+        _usage.cpuBuffers += m_vertices.capacity() * sizeof(T);
+    }
+
     void clear() {
         // Clear vertices for next frame
         m_nVertices = 0;
@@ -246,6 +246,18 @@ size_t MeshBase::bufferSize() const {
     return m_nVertices * m_vertexLayout->getStride() + m_nIndices * sizeof(GLushort);
 }
 
+void MeshBase::addMemoryUsage(MemoryUsage& _usage) const {
+    if (m_isUploaded) {
+        _usage.gpuBuffers += bufferSize();
+    }
+    if (m_glVertexData) {
+        _usage.cpuBuffers += m_nVertices * m_vertexLayout->getStride();
+    }
+    if (m_glIndexData) {
+        _usage.cpuBuffers += m_nIndices * sizeof(GLushort);
+    }
+}
+
 // Add indices by collecting them into batches to draw as much as
 // possible in one draw call.  The indices must be shifted by the
 // number of vertices that are present in the current batch.
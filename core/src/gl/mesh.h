@@ -66,6 +66,11 @@ public:
 
     size_t bufferSize() const;
 
+    /*
+     * Adds the uploaded buffers and the compiled data that waits for upload
+     */
+    void addMemoryUsage(MemoryUsage& _usage) const;
+
 protected:
 
     int m_generation; // Generation in which this mesh's GL handles were created
@@ -126,6 +131,15 @@ struct MeshData {
         indices.clear();
         vertices.clear();
     }
+
+    /* Appends the batches of @_other. Indices are relative to their batch,
+     * so they stay valid */
+    void append(MeshData<T>& _other) {
+        indices.insert(indices.end(), _other.indices.begin(), _other.indices.end());
+        vertices.insert(vertices.end(), _other.vertices.begin(), _other.vertices.end());
+        offsets.insert(offsets.end(), _other.offsets.begin(), _other.offsets.end());
+        _other.clear();
+    }
 };
 
 template<class T>
@@ -142,6 +156,13 @@ public:
         return MeshBase::bufferSize();
     }
 
+    void addMemoryUsage(MemoryUsage& _usage) const override {
+        MeshBase::addMemoryUsage(_usage);
+    }
+
+    size_t numVertices() const override { return m_nVertices; }
+    size_t numIndices() const override { return m_nIndices; }
+
     bool draw(ShaderProgram& _shader) override {
         return MeshBase::draw(_shader);
     }
@@ -204,6 +204,15 @@ bool Texture::isValid() const {
         && m_glHandle != 0);
 }
 
+void Texture::addMemoryUsage(MemoryUsage& _usage) const {
+    if (m_glHandle != 0) {
+        size_t size = m_width * m_height * bytesPerPixel();
+        // A full mipmap chain adds a third
+        _usage.gpuTextures += m_generateMipmaps ? size + size / 3 : size;
+    }
+    _usage.cpuTextures += m_data.capacity() * sizeof(GLuint);
+}
+
 void Texture::update(GLuint _textureUnit) {
 
     checkValidity();
@@ -290,7 +299,7 @@ bool Texture::isRepeatWrapping(TextureWrapping _wrapping) {
     return _wrapping.wraps == GL_REPEAT || _wrapping.wrapt == GL_REPEAT;
 }
 
-size_t Texture::bytesPerPixel() {
+size_t Texture::bytesPerPixel() const {
     switch (m_options.internalFormat) {
         case GL_ALPHA:
         case GL_LUMINANCE:
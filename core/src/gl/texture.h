@@ -1,6 +1,7 @@
 #pragma once
 
 #include "gl.h"
+#include "util/memoryUsage.h"
 
 #include <vector>
 #include <memory>
@@ -78,6 +79,9 @@ public:
     /* Checks whether the texture has valid data and has been successfully uploaded to GPU */
     bool isValid() const;
 
+    /* Adds the uploaded texture and the texture data kept for re-upload to @_usage */
+    void addMemoryUsage(MemoryUsage& _usage) const;
+
     typedef std::pair<GLuint, GLuint> TextureSlot;
 
     static void invalidateAllTextures();
@@ -112,7 +116,7 @@ protected:
 
 private:
 
-    size_t bytesPerPixel();
+    size_t bytesPerPixel() const;
 
     bool m_generateMipmaps;
 };
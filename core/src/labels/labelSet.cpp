@@ -20,4 +20,8 @@ void LabelSet::setLabels(std::vector<std::unique_ptr<Label>>& _labels) {
     _labels.clear();
 }
 
+void LabelSet::addMemoryUsage(MemoryUsage& _usage) const {
+    _usage.labels += m_labels.capacity() * sizeof(std::unique_ptr<Label>);
+}
+
 }
@@ -19,6 +19,8 @@ public:
 
     size_t bufferSize() const override { return 0; }
 
+    void addMemoryUsage(MemoryUsage& _usage) const override;
+
     void setLabels(std::vector<std::unique_ptr<Label>>& _labels);
 
     void reset();
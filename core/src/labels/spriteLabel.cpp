@@ -8,14 +8,15 @@ namespace Tangram {
 using namespace LabelProperty;
 
 const float SpriteVertex::position_scale = 4.0f;
-const float SpriteVertex::alpha_scale = 65535.0f;
 const float SpriteVertex::texture_scale = 65535.0f;
 
+static_assert(sizeof(SpriteVertex) == 12, "SpriteVertex does not match the PointStyle vertex layout");
+
 SpriteLabel::SpriteLabel(Label::Transform _transform, glm::vec2 _size, Label::Options _options,
                          float _extrudeScale, LabelProperty::Anchor _anchor,
                          SpriteLabels& _labels, size_t _labelsPos)
     : Label(_transform, _size, Label::Type::point, _options, _anchor),
-      m_labels(_labels),
+      m_labels(&_labels),
       m_labelsPos(_labelsPos),
       m_extrudeScale(_extrudeScale) {
 
@@ -59,15 +60,13 @@ void SpriteLabel::pushTransform() {
     //     vertex_pos.xy += clamp(dz, 0.0, 1.0) * UNPACK_EXTRUDE(a_extrude.xy);
     // }
 
-    auto& quad = m_labels.quads[m_labelsPos];
+    auto& quad = m_labels->quads[m_labelsPos];
 
     SpriteVertex::State state {
-        quad.color,
-        uint16_t(m_transform.state.alpha * SpriteVertex::alpha_scale),
-        0,
+        SpriteVertex::packColor(quad.color, m_transform.state.alpha)
     };
 
-    auto& style = m_labels.m_style;
+    auto& style = m_labels->m_style;
 
     auto* quadVertices = style.getMesh()->pushQuad();
 
@@ -82,4 +81,9 @@ void SpriteLabel::pushTransform() {
     }
 }
 
+void SpriteLabels::addMemoryUsage(MemoryUsage& _usage) const {
+    LabelSet::addMemoryUsage(_usage);
+    _usage.labels += m_labels.size() * sizeof(SpriteLabel) + quads.capacity() * sizeof(SpriteQuad);
+}
+
 }
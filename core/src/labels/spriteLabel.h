@@ -12,13 +12,17 @@ struct SpriteVertex {
     glm::i16vec2 pos;
     glm::u16vec2 uv;
     struct State {
+        // Label alpha is multiplied into the color alpha
         uint32_t color;
-        uint16_t alpha;
-        uint16_t scale;
     } state;
 
+    /* Color of the vertices of a quad with @_color, drawn at label alpha @_alpha */
+    static uint32_t packColor(uint32_t _color, float _alpha) {
+        uint32_t alpha = (_color >> 24) * _alpha + 0.5f;
+        return (_color & 0x00ffffff) | (alpha << 24);
+    }
+
     static const float position_scale;
-    static const float alpha_scale;
     static const float texture_scale;
 };
 
@@ -33,14 +37,24 @@ public:
 
     void pushTransform() override;
 
+    /* Index of the quad of this label in its SpriteLabels */
+    size_t quadIndex() const { return m_labelsPos; }
+    void setQuadIndex(size_t _index) { m_labelsPos = _index; }
+
+    /* Move this label to @_labels, where its quad is @_quadOffset quads later */
+    void relocate(const SpriteLabels& _labels, size_t _quadOffset) {
+        m_labels = &_labels;
+        m_labelsPos += _quadOffset;
+    }
+
 private:
 
     void applyAnchor(const glm::vec2& _dimension, const glm::vec2& _origin,
         LabelProperty::Anchor _anchor) override;
     
     // Back-pointer to owning container and position
-    const SpriteLabels& m_labels;
-    const size_t m_labelsPos;
+    const SpriteLabels* m_labels;
+    size_t m_labelsPos;
 
     float m_extrudeScale;
 };
@@ -62,6 +76,8 @@ public:
         quads = std::move(_quads);
     }
 
+    void addMemoryUsage(MemoryUsage& _usage) const override;
+
     // TODO: hide within class if needed
     const PointStyle& m_style;
     std::vector<SpriteQuad> quads;
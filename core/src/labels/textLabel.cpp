@@ -16,7 +16,7 @@ TextLabel::TextLabel(Label::Transform _transform, Type _type, Label::Options _op
                      Anchor _anchor, TextLabel::FontVertexAttributes _attrib,
                      glm::vec2 _dim,  TextLabels& _labels, Range _vertexRange)
     : Label(_transform, _dim, _type, _options, _anchor),
-      m_textLabels(_labels),
+      m_textLabels(&_labels),
       m_vertexRange(_vertexRange),
       m_fontAttrib(_attrib) {
 
@@ -54,9 +54,9 @@ void TextLabel::pushTransform() {
         uint16_t(m_fontAttrib.fontScale),
     };
 
-    auto it = m_textLabels.quads.begin() + m_vertexRange.start;
+    auto it = m_textLabels->quads.begin() + m_vertexRange.start;
     auto end = it + m_vertexRange.length;
-    auto& style = m_textLabels.style;
+    auto& style = m_textLabels->style;
 
     glm::i16vec2 sp = glm::i16vec2(m_transform.state.screenPos * TextVertex::position_scale);
 
@@ -87,4 +87,9 @@ void TextLabels::setQuads(std::vector<GlyphQuad>&& _quads, std::bitset<FontConte
 
 }
 
+void TextLabels::addMemoryUsage(MemoryUsage& _usage) const {
+    LabelSet::addMemoryUsage(_usage);
+    _usage.labels += m_labels.size() * sizeof(TextLabel) + quads.capacity() * sizeof(GlyphQuad);
+}
+
 }
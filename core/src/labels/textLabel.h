@@ -10,7 +10,8 @@ class TextLabels;
 class TextStyle;
 
 struct GlyphQuad {
-    size_t atlas;
+    // Index of the glyph texture, less than FontContext::max_textures
+    uint16_t atlas;
     struct {
         glm::i16vec2 pos;
         glm::u16vec2 uv;
@@ -49,6 +50,13 @@ public:
 
     Range& quadRange() { return m_vertexRange; }
 
+    /* Move this label to @_labels, where its quads start @_quadOffset
+     * quads later */
+    void relocate(const TextLabels& _labels, int _quadOffset) {
+        m_textLabels = &_labels;
+        m_vertexRange.start += _quadOffset;
+    }
+
 protected:
 
     void pushTransform() override;
@@ -58,7 +66,7 @@ private:
                      LabelProperty::Anchor _anchor) override;
 
     // Back-pointer to owning container
-    const TextLabels& m_textLabels;
+    const TextLabels* m_textLabels;
     // first vertex and count in m_textLabels quads
     Range m_vertexRange;
 
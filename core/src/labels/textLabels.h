@@ -19,6 +19,8 @@ public:
 
     void setQuads(std::vector<GlyphQuad>&& _quads, std::bitset<FontContext::max_textures> _atlasRefs);
 
+    void addMemoryUsage(MemoryUsage& _usage) const override;
+
     std::vector<GlyphQuad> quads;
     const TextStyle& style;
 
@@ -45,8 +45,9 @@ std::string stringFromFile(const char* _path);
  */
 unsigned char* bytesFromFile(const char* _path, size_t& _size);
 
-/* Function type for receiving data from a successful network request */
-using UrlCallback = std::function<void(std::vector<char>&&)>;
+/* Function type for receiving data from a network request. @_success is false
+ * when the request failed, the data is empty then */
+using UrlCallback = std::function<void(std::vector<char>&& _rawData, bool _success)>;
 
 /* Start retrieving data from a URL asynchronously
  *
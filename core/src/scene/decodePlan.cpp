@@ -0,0 +1,112 @@
+#include "decodePlan.h"
+
+#include "scene/dataLayer.h"
+#include "scene/filters.h"
+#include "scene/jsFunction.h"
+#include "scene/scene.h"
+#include "scene/styleParam.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace Tangram {
+
+// Properties read by styles without being named in the scene: the default
+// text source and the extrusion heights
+static const std::vector<std::string> s_styleKeys = { "name", "height", "min_height" };
+
+DecodePlan::DecodePlan(const Scene& _scene, const std::string& _source) {
+
+    for (const auto& datalayer : _scene.layers()) {
+        if (datalayer.source() != _source) { continue; }
+
+        m_layers.insert(m_layers.end(), datalayer.collections().begin(),
+                        datalayer.collections().end());
+
+        addLayerKeys(datalayer);
+    }
+
+    for (const auto& function : _scene.functions()) {
+        addFunctionKeys(function);
+    }
+
+    for (const auto& key : s_styleKeys) {
+        addKey(key);
+    }
+
+    std::sort(m_layers.begin(), m_layers.end());
+    m_layers.erase(std::unique(m_layers.begin(), m_layers.end()), m_layers.end());
+
+    std::sort(m_keys.begin(), m_keys.end());
+    m_keys.erase(std::unique(m_keys.begin(), m_keys.end()), m_keys.end());
+}
+
+bool DecodePlan::hasLayer(const std::string& _name) const {
+    return std::binary_search(m_layers.begin(), m_layers.end(), _name);
+}
+
+bool DecodePlan::hasKey(const std::string& _key) const {
+    return m_allKeys || std::binary_search(m_keys.begin(), m_keys.end(), _key);
+}
+
+void DecodePlan::addKey(const std::string& _key) {
+    // Skip keywords like $zoom and $geometry, which are not feature properties
+    if (_key.empty() || _key[0] == '$') { return; }
+
+    m_keys.push_back(_key);
+}
+
+void DecodePlan::addLayerKeys(const SceneLayer& _layer) {
+
+    addFilterKeys(_layer.filter());
+
+    for (const auto& rule : _layer.rules()) {
+        for (const auto& param : rule.parameters) {
+            if (param.key == StyleParamKey::interactive ||
+                param.key == StyleParamKey::text_interactive) {
+                // Picking returns all properties of interactive features
+                if (param.function >= 0 ||
+                    (param.value.is<bool>() && param.value.get<bool>())) {
+                    m_allKeys = true;
+                }
+                continue;
+            }
+            if (param.key != StyleParamKey::text_source || param.function >= 0) { continue; }
+            if (!param.value.is<std::string>()) { continue; }
+
+            // A text source is a key or a list of fallback keys, see
+            // TextStyleBuilder::resolveTextSource()
+            const auto& textSource = param.value.get<std::string>();
+            addKey(textSource);
+
+            std::stringstream ss(textSource);
+            std::string key;
+            while (std::getline(ss, key, ',')) {
+                addKey(key);
+            }
+        }
+    }
+
+    for (const auto& sublayer : _layer.sublayers()) {
+        addLayerKeys(sublayer);
+    }
+}
+
+void DecodePlan::addFilterKeys(const Filter& _filter) {
+    if (_filter.isOperator()) {
+        for (const auto& operand : _filter.operands()) {
+            addFilterKeys(operand);
+        }
+    } else {
+        // Function filters are covered by addFunctionKeys()
+        addKey(_filter.key());
+    }
+}
+
+void DecodePlan::addFunctionKeys(const std::string& _function) {
+    if (!JsFunction::featureKeys(_function, m_keys)) {
+        m_allKeys = true;
+    }
+}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Tangram {
+
+class Scene;
+class SceneLayer;
+struct Filter;
+
+/* The parts of the tile data of one DataSource that a Scene reads
+ *
+ * Lists the collections referenced by the data layers of the source and
+ * the feature property keys read by their filters and draw rules, by JS
+ * functions and by the styles themselves. A source may skip everything
+ * else while decoding a tile.
+ */
+class DecodePlan {
+
+public:
+
+    DecodePlan(const Scene& _scene, const std::string& _source);
+
+    bool hasLayer(const std::string& _name) const;
+
+    bool hasKey(const std::string& _key) const;
+
+    /* True when a JS function accesses feature properties by computed
+     * names or a draw rule makes features interactive, so that no property
+     * may be skipped */
+    bool allKeys() const { return m_allKeys; }
+
+    const auto& layers() const { return m_layers; }
+    const auto& keys() const { return m_keys; }
+
+private:
+
+    void addLayerKeys(const SceneLayer& _layer);
+
+    void addFilterKeys(const Filter& _filter);
+
+    void addFunctionKeys(const std::string& _function);
+
+    void addKey(const std::string& _key);
+
+    // Sorted, unique
+    std::vector<std::string> m_layers;
+    std::vector<std::string> m_keys;
+
+    bool m_allKeys = false;
+};
+
+}
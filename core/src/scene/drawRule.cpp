@@ -1,5 +1,7 @@
 #include "drawRule.h"
 
+#include "data/propertyItem.h"
+#include "data/tileData.h"
 #include "tile/tileBuilder.h"
 #include "scene/scene.h"
 #include "scene/sceneLayer.h"
@@ -11,6 +13,10 @@
 #include "util/hash.h"
 
 #include <algorithm>
+#include <cassert>
+
+// Maximum number of distinct matches cached per tile
+#define MAX_CACHED_MATCHES 1024
 
 namespace Tangram {
 
@@ -126,8 +132,13 @@ bool DrawRuleMergeSet::match(const Feature& _feature, const SceneLayer& _layer,
         return false;
     }
 
+    // Only root layers carry the compiled filters of their tree
+    assert(_layer.filterProgram());
+    const auto& program = *_layer.filterProgram();
+    program.begin(m_filterState);
+
     // If the first filter doesn't match, return immediately
-    if (!_layer.filter().eval(_feature, _ctx)) { return false; }
+    if (!program.eval(_layer.filterId(), _feature, _ctx, m_filterState)) { return false; }
 
     m_queuedLayers.push_back(&_layer);
 
@@ -148,7 +159,7 @@ bool DrawRuleMergeSet::match(const Feature& _feature, const SceneLayer& _layer,
                 continue;
             }
 
-            if (sublayer.filter().eval(_feature, _ctx)) {
+            if (program.eval(sublayer.filterId(), _feature, _ctx, m_filterState)) {
                 m_queuedLayers.push_back(&sublayer);
             }
         }
@@ -157,16 +168,79 @@ bool DrawRuleMergeSet::match(const Feature& _feature, const SceneLayer& _layer,
     return true;
 }
 
+bool DrawRuleMergeSet::matchCached(const Feature& _feature, const SceneLayer& _layer, StyleContext& _ctx) {
+
+    assert(_layer.filterProgram());
+    const auto& program = *_layer.filterProgram();
+
+    // Results of JS functions may depend on any property
+    if (!_layer.visible() || program.hasFunctions()) {
+        return match(_feature, _layer, _ctx);
+    }
+
+    const auto& keys = program.keys();
+    int geometryType = static_cast<int>(_feature.geometryType);
+
+    m_signature.clear();
+    for (auto key : keys) { m_signature.push_back(&_feature.props.get(key)); }
+
+    size_t hash = 0;
+    hash_combine(hash, &_layer);
+    hash_combine(hash, geometryType);
+    for (auto* value : m_signature) {
+        hash_combine(hash, Value::visit(*value, value_hash{}));
+    }
+
+    auto it = m_cache.find(hash);
+    if (it != m_cache.end()) {
+        for (const auto& entry : it->second) {
+            if (entry.layer != &_layer || entry.geometryType != geometryType) { continue; }
+
+            bool equal = true;
+            for (size_t i = 0; i < keys.size() && equal; i++) {
+                equal = entry.values[i] == *m_signature[i];
+            }
+            if (!equal) { continue; }
+
+            m_cacheHits++;
+            _ctx.setFeature(_feature);
+            m_matchedRules = entry.rules;
+            return entry.matched;
+        }
+    }
+
+    m_cacheMisses++;
+    bool matched = match(_feature, _layer, _ctx);
+
+    if (m_cacheSize < MAX_CACHED_MATCHES) {
+        std::vector<Value> values;
+        values.reserve(keys.size());
+        for (auto* value : m_signature) { values.push_back(*value); }
+
+        m_cache[hash].push_back({ &_layer, geometryType, std::move(values), m_matchedRules, matched });
+        m_cacheSize++;
+    }
+
+    return matched;
+}
+
+void DrawRuleMergeSet::clearCache() {
+    m_cache.clear();
+    m_cacheSize = 0;
+}
+
 void DrawRuleMergeSet::apply(const Feature& _feature, const SceneLayer& _layer,
                              StyleContext& _ctx, TileBuilder& _builder) {
 
     // If no rules matched the feature, return immediately
-    if (!match(_feature, _layer, _ctx)) { return; }
+    if (!matchCached(_feature, _layer, _ctx)) { return; }
 
     // For each matched rule, find the style to be used and
     // build the feature with the rule's parameters
     for (auto& rule : m_matchedRules) {
 
+        if (_builder.isCanceled()) { return; }
+
         StyleBuilder* style = _builder.getStyleBuilder(rule.getStyleName());
         if (!style) {
             LOGN("Invalid style %s", rule.getStyleName().c_str());
@@ -178,41 +252,7 @@ void DrawRuleMergeSet::apply(const Feature& _feature, const SceneLayer& _layer,
             continue;
         }
 
-        bool valid = true;
-        for (size_t i = 0; i < StyleParamKeySize; ++i) {
-
-            if (!rule.active[i]) {
-                rule.params[i].param = nullptr;
-                continue;
-            }
-
-            auto*& param = rule.params[i].param;
-
-            // Evaluate JS functions and Stops
-            if (param->function >= 0) {
-
-                // Copy param into 'evaluated' and point param to the evaluated StyleParam.
-                m_evaluated[i] = *param;
-                param = &m_evaluated[i];
-
-                if (!_ctx.evalStyle(param->function, param->key, m_evaluated[i].value)) {
-                    if (StyleParam::isRequired(param->key)) {
-                        valid = false;
-                        break;
-                    } else {
-                        rule.active[i] = false;
-                    }
-                }
-            } else if (param->stops) {
-                m_evaluated[i] = *param;
-                param = &m_evaluated[i];
-
-                Stops::eval(*param->stops, param->key, _ctx.getKeywordZoom(),
-                            m_evaluated[i].value);
-            }
-        }
-
-        if (valid) {
+        if (evaluateRule(rule, _ctx)) {
 
             // build outline explicitly with outline style
             const auto& outlineStyleName = rule.findParameter(StyleParamKey::outline_style);
@@ -234,6 +274,53 @@ void DrawRuleMergeSet::apply(const Feature& _feature, const SceneLayer& _layer,
     }
 }
 
+bool DrawRuleMergeSet::evaluateRule(DrawRule& _rule, StyleContext& _ctx) {
+
+    float zoom = _ctx.getKeywordZoom();
+    if (zoom != m_zoom) {
+        m_zoomParams.clear();
+        m_zoom = zoom;
+    }
+
+    for (size_t i = 0; i < StyleParamKeySize; ++i) {
+
+        if (!_rule.active[i]) {
+            _rule.params[i].param = nullptr;
+            continue;
+        }
+
+        auto*& param = _rule.params[i].param;
+
+        // Evaluate JS functions and Stops
+        if (param->function >= 0) {
+
+            // Copy param into 'evaluated' and point param to the evaluated StyleParam.
+            m_evaluated[i] = *param;
+            param = &m_evaluated[i];
+
+            if (!_ctx.evalStyle(param->function, param->key, m_evaluated[i].value)) {
+                if (StyleParam::isRequired(param->key)) {
+                    return false;
+                } else {
+                    _rule.active[i] = false;
+                }
+            }
+        } else if (param->stops) {
+
+            // Stops depend only on the zoom: evaluate each once per zoom
+            // and point all features to the result
+            auto it = m_zoomParams.find(param);
+            if (it == m_zoomParams.end()) {
+                it = m_zoomParams.emplace(param, *param).first;
+                Stops::eval(*param->stops, param->key, zoom, it->second.value);
+            }
+            param = &it->second;
+        }
+    }
+
+    return true;
+}
+
 void DrawRuleMergeSet::mergeRules(const SceneLayer& _layer) {
 
     size_t pos, end = m_matchedRules.size();
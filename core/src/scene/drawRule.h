@@ -1,10 +1,12 @@
 #pragma once
 
+#include "scene/filterProgram.h"
 #include "scene/styleParam.h"
 
 #include <vector>
 #include <set>
 #include <bitset>
+#include <unordered_map>
 
 namespace Tangram {
 
@@ -128,9 +130,34 @@ public:
     // internal
     void mergeRules(const SceneLayer& _layer);
 
+    /* Points the params of @_rule to their values for the current feature
+     * and zoom, evaluating JS functions and Stops. Returns false when a
+     * required param has no value */
+    bool evaluateRule(DrawRule& _rule, StyleContext& _ctx);
+
+    /* Sets matchedRules() like match(), reusing the result for a feature
+     * with the same values of the keys read by the filters of @_layer */
+    bool matchCached(const Feature& _feature, const SceneLayer& _layer, StyleContext& _ctx);
+
     auto& matchedRules() { return m_matchedRules; }
 
+    /* Drops the cached matches, called when the build of a tile starts */
+    void clearCache();
+
+    size_t cacheHits() const { return m_cacheHits; }
+    size_t cacheMisses() const { return m_cacheMisses; }
+
 private:
+    /* Matched and merged rules of a layer for features with equal values
+     * of the keys read by the layer filters. */
+    struct CacheEntry {
+        const SceneLayer* layer;
+        int geometryType;
+        std::vector<Value> values;
+        std::vector<DrawRule> rules;
+        bool matched;
+    };
+
     // Reusable containers 'matchedRules' and 'queuedLayers'
     std::vector<DrawRule> m_matchedRules;
     std::vector<const SceneLayer*> m_queuedLayers;
@@ -138,6 +165,21 @@ private:
     // Container for dynamically-evaluated parameters
     StyleParam m_evaluated[StyleParamKeySize];
 
+    // Params with Stops, evaluated for m_zoom
+    std::unordered_map<const StyleParam*, StyleParam> m_zoomParams;
+    float m_zoom = -1;
+
+    // Per-feature caches of filter evaluation
+    FilterProgram::State m_filterState;
+
+    // Matches by hash of their layer, geometry type and values
+    std::unordered_map<size_t, std::vector<CacheEntry>> m_cache;
+    // Values of the keys read by the filters, for the current feature
+    std::vector<const Value*> m_signature;
+    size_t m_cacheSize = 0;
+    size_t m_cacheHits = 0;
+    size_t m_cacheMisses = 0;
+
 };
 
 }
@@ -0,0 +1,226 @@
+#include "filterProgram.h"
+
+#include "data/propertyItem.h"
+#include "data/tileData.h"
+#include "scene/sceneLayer.h"
+#include "scene/styleContext.h"
+
+#include <algorithm>
+
+namespace Tangram {
+
+constexpr int32_t FilterProgram::MATCH;
+constexpr int32_t FilterProgram::MISS;
+
+/* Whether two leaf filters always give the same result for a feature */
+static bool sameTest(const Filter& _a, const Filter& _b) {
+    auto& a = _a.data;
+    auto& b = _b.data;
+
+    if (a.get_type_index() != b.get_type_index()) { return false; }
+
+    switch (a.get_type_index()) {
+    case Filter::Data::type<Filter::Existence>::value: {
+        auto& fa = a.get<Filter::Existence>();
+        auto& fb = b.get<Filter::Existence>();
+        return fa.key == fb.key && fa.exists == fb.exists;
+    }
+    case Filter::Data::type<Filter::EqualitySet>::value: {
+        auto& fa = a.get<Filter::EqualitySet>();
+        auto& fb = b.get<Filter::EqualitySet>();
+        return fa.key == fb.key && fa.values == fb.values;
+    }
+    case Filter::Data::type<Filter::Equality>::value: {
+        auto& fa = a.get<Filter::Equality>();
+        auto& fb = b.get<Filter::Equality>();
+        return fa.key == fb.key && fa.value == fb.value;
+    }
+    case Filter::Data::type<Filter::Range>::value: {
+        auto& fa = a.get<Filter::Range>();
+        auto& fb = b.get<Filter::Range>();
+        return fa.key == fb.key && fa.min == fb.min && fa.max == fb.max;
+    }
+    case Filter::Data::type<Filter::Function>::value:
+        return a.get<Filter::Function>().id == b.get<Filter::Function>().id;
+
+    default:
+        break;
+    }
+    return false;
+}
+
+FilterProgram::FilterProgram(SceneLayer& _layer) {
+    compileLayer(_layer);
+}
+
+void FilterProgram::compileLayer(SceneLayer& _layer) {
+
+    _layer.m_filterId = m_entries.size();
+    m_entries.push_back(compile(_layer.m_filter, MATCH, MISS));
+
+    for (auto& sublayer : _layer.m_sublayers) {
+        compileLayer(sublayer);
+    }
+}
+
+int32_t FilterProgram::compile(const Filter& _filter, int32_t _onTrue, int32_t _onFalse) {
+
+    auto& data = _filter.data;
+
+    // Operands are emitted last to first, so that the instruction following
+    // each operand is known when it is emitted
+    switch (data.get_type_index()) {
+
+    case Filter::Data::type<Filter::OperatorAll>::value: {
+        auto& operands = data.get<Filter::OperatorAll>().operands;
+        int32_t next = _onTrue;
+        for (auto it = operands.rbegin(); it != operands.rend(); ++it) {
+            next = compile(*it, next, _onFalse);
+        }
+        return next;
+    }
+    case Filter::Data::type<Filter::OperatorAny>::value: {
+        auto& operands = data.get<Filter::OperatorAny>().operands;
+        int32_t next = _onFalse;
+        for (auto it = operands.rbegin(); it != operands.rend(); ++it) {
+            next = compile(*it, _onTrue, next);
+        }
+        return next;
+    }
+    case Filter::Data::type<Filter::OperatorNone>::value: {
+        auto& operands = data.get<Filter::OperatorNone>().operands;
+        int32_t next = _onTrue;
+        for (auto it = operands.rbegin(); it != operands.rend(); ++it) {
+            next = compile(*it, _onFalse, next);
+        }
+        return next;
+    }
+    case Filter::Data::type<none_type>::value:
+        return _onTrue;
+
+    default:
+        break;
+    }
+
+    m_ops.push_back({ addTest(_filter), _onTrue, _onFalse });
+    return m_ops.size() - 1;
+}
+
+uint32_t FilterProgram::addTest(const Filter& _filter) {
+
+    for (size_t i = 0; i < m_tests.size(); i++) {
+        if (sameTest(m_tests[i].filter, _filter)) { return i; }
+    }
+
+    Test test { _filter, -1, FilterKeyword::undefined };
+
+    auto& data = _filter.data;
+    switch (data.get_type_index()) {
+    case Filter::Data::type<Filter::Existence>::value:
+        test.key = addKey(data.get<Filter::Existence>().key);
+        break;
+    case Filter::Data::type<Filter::EqualitySet>::value: {
+        auto& f = data.get<Filter::EqualitySet>();
+        test.keyword = f.keyword;
+        if (f.keyword == FilterKeyword::undefined) { test.key = addKey(f.key); }
+        break;
+    }
+    case Filter::Data::type<Filter::Equality>::value: {
+        auto& f = data.get<Filter::Equality>();
+        test.keyword = f.keyword;
+        if (f.keyword == FilterKeyword::undefined) { test.key = addKey(f.key); }
+        break;
+    }
+    case Filter::Data::type<Filter::Range>::value: {
+        auto& f = data.get<Filter::Range>();
+        test.keyword = f.keyword;
+        if (f.keyword == FilterKeyword::undefined) { test.key = addKey(f.key); }
+        break;
+    }
+    case Filter::Data::type<Filter::Function>::value:
+        m_hasFunctions = true;
+        break;
+    default:
+        break;
+    }
+
+    m_tests.push_back(std::move(test));
+    return m_tests.size() - 1;
+}
+
+int32_t FilterProgram::addKey(Atom _key) {
+
+    auto it = std::find(m_keys.begin(), m_keys.end(), _key);
+    if (it != m_keys.end()) { return it - m_keys.begin(); }
+
+    m_keys.push_back(_key);
+    return m_keys.size() - 1;
+}
+
+void FilterProgram::begin(State& _state) const {
+
+    if (_state.testStamps.size() < m_tests.size()) {
+        _state.testStamps.resize(m_tests.size(), 0);
+        _state.testResults.resize(m_tests.size(), 0);
+    }
+    if (_state.keyStamps.size() < m_keys.size()) {
+        _state.keyStamps.resize(m_keys.size(), 0);
+        _state.keyValues.resize(m_keys.size(), nullptr);
+    }
+
+    if (++_state.stamp == 0) {
+        // Stamps wrapped around, forget the results of earlier features
+        std::fill(_state.testStamps.begin(), _state.testStamps.end(), 0);
+        std::fill(_state.keyStamps.begin(), _state.keyStamps.end(), 0);
+        _state.stamp = 1;
+    }
+}
+
+bool FilterProgram::runTest(uint32_t _test, const Feature& _feature, StyleContext& _ctx, State& _state) const {
+
+    if (_state.testStamps[_test] == _state.stamp) {
+        return _state.testResults[_test];
+    }
+
+    const Test& test = m_tests[_test];
+    auto& data = test.filter.data;
+
+    const Value* value = nullptr;
+    if (test.key >= 0) {
+        if (_state.keyStamps[test.key] != _state.stamp) {
+            _state.keyValues[test.key] = &_feature.props.get(m_keys[test.key]);
+            _state.keyStamps[test.key] = _state.stamp;
+        }
+        value = _state.keyValues[test.key];
+    } else if (test.keyword != FilterKeyword::undefined) {
+        value = &_ctx.getKeyword(test.keyword);
+    }
+
+    bool result;
+    if (data.is<Filter::Existence>()) {
+        result = data.get<Filter::Existence>().exists == !value->is<none_type>();
+    } else if (data.is<Filter::Function>()) {
+        result = _ctx.evalFilter(data.get<Filter::Function>().id);
+    } else {
+        result = test.filter.matchValue(*value);
+    }
+
+    _state.testStamps[_test] = _state.stamp;
+    _state.testResults[_test] = result;
+
+    return result;
+}
+
+bool FilterProgram::eval(size_t _filterId, const Feature& _feature, StyleContext& _ctx, State& _state) const {
+
+    int32_t pc = m_entries[_filterId];
+
+    while (pc >= 0) {
+        const Op& op = m_ops[pc];
+        pc = runTest(op.test, _feature, _ctx, _state) ? op.onTrue : op.onFalse;
+    }
+
+    return pc == MATCH;
+}
+
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "scene/filters.h"
+#include "util/atom.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Tangram {
+
+class SceneLayer;
+class StyleContext;
+struct Feature;
+
+/* Filters of a layer tree compiled into one decision program
+ *
+ * Each distinct leaf filter (Equality, Range, Existence, Function..) becomes
+ * a test. Filters of the tree that are equal share a test. Operators become
+ * branches between tests: every instruction runs one test and jumps to the
+ * next instruction for its result, or ends with a match or a miss. A filter
+ * is evaluated by a loop over these jumps, without recursion.
+ *
+ * Test results and the property values they read are cached in a State for
+ * the current feature. Sibling sublayers that check the same key then look
+ * it up only once.
+ */
+class FilterProgram {
+
+public:
+
+    /* Per-feature caches, owned by the thread evaluating programs. One State
+     * may be used with several programs. */
+    struct State {
+        uint32_t stamp = 0;
+
+        std::vector<uint32_t> testStamps;
+        std::vector<uint8_t> testResults;
+
+        std::vector<uint32_t> keyStamps;
+        std::vector<const Value*> keyValues;
+    };
+
+    /* Compiles the filters of @_layer and its sublayers and numbers the
+     * layers with their filterId() */
+    explicit FilterProgram(SceneLayer& _layer);
+
+    /* Starts the evaluation of a new feature, invalidating the caches of
+     * @_state */
+    void begin(State& _state) const;
+
+    /* Returns whether the filter of the layer with @_filterId matches
+     * @_feature. begin() must have been called for this feature. */
+    bool eval(size_t _filterId, const Feature& _feature, StyleContext& _ctx, State& _state) const;
+
+    size_t numTests() const { return m_tests.size(); }
+    size_t numInstructions() const { return m_ops.size(); }
+    size_t numKeys() const { return m_keys.size(); }
+
+    /* Property keys read by the filters */
+    const std::vector<Atom>& keys() const { return m_keys; }
+
+    /* Whether any filter calls a JS function */
+    bool hasFunctions() const { return m_hasFunctions; }
+
+private:
+
+    // Jump targets ending the evaluation
+    static constexpr int32_t MATCH = -1;
+    static constexpr int32_t MISS = -2;
+
+    struct Test {
+        Filter filter;
+        // Index in m_keys of the property read, -1 for keywords and functions
+        int32_t key;
+        FilterKeyword keyword;
+    };
+
+    struct Op {
+        uint32_t test;
+        int32_t onTrue;
+        int32_t onFalse;
+    };
+
+    void compileLayer(SceneLayer& _layer);
+
+    /* Emits the instructions of @_filter, returns the entry point */
+    int32_t compile(const Filter& _filter, int32_t _onTrue, int32_t _onFalse);
+
+    uint32_t addTest(const Filter& _filter);
+
+    int32_t addKey(Atom _key);
+
+    bool runTest(uint32_t _test, const Feature& _feature, StyleContext& _ctx, State& _state) const;
+
+    std::vector<Op> m_ops;
+    std::vector<Test> m_tests;
+    std::vector<Atom> m_keys;
+
+    // Entry point of each layer filter, by filterId
+    std::vector<int32_t> m_entries;
+
+    bool m_hasFunctions = false;
+};
+
+}
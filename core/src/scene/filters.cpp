@@ -34,7 +34,7 @@ void Filter::print(int _indent) const {
     }
     case Data::type<Existence>::value: {
         auto& f = data.get<Existence>();
-        logMsg("%*s existence - key:%s\n", _indent, "", f.key.c_str());
+        logMsg("%*s existence - key:%s\n", _indent, "", f.key.str().c_str());
         break;
     }
     case Data::type<EqualitySet>::value: {
@@ -42,13 +42,13 @@ void Filter::print(int _indent) const {
         if (f.values[0].is<std::string>()) {
             logMsg("%*s equality set - keyword:%d key:%s val:%s\n", _indent, "",
                    f.keyword != FilterKeyword::undefined,
-                   f.key.c_str(),
+                   f.key.str().c_str(),
                    f.values[0].get<std::string>().c_str());
         }
         if (f.values[0].is<double>()) {
             logMsg("%*s equality - keyword:%d key:%s val:%f\n", _indent, "",
                    f.keyword != FilterKeyword::undefined,
-                   f.key.c_str(),
+                   f.key.str().c_str(),
                    f.values[0].get<double>());
         }
         break;
@@ -58,13 +58,13 @@ void Filter::print(int _indent) const {
         if (f.value.is<std::string>()) {
             logMsg("%*s equality - keyword:%d key:%s val:%s\n", _indent, "",
                    f.keyword != FilterKeyword::undefined,
-                   f.key.c_str(),
+                   f.key.str().c_str(),
                    f.value.get<std::string>().c_str());
         }
         if (f.value.is<double>()) {
             logMsg("%*s equality - keyword:%d key:%s val:%f\n", _indent, "",
                    f.keyword != FilterKeyword::undefined,
-                   f.key.c_str(),
+                   f.key.str().c_str(),
                    f.value.get<double>());
         }
         break;
@@ -73,7 +73,7 @@ void Filter::print(int _indent) const {
         auto& f = data.get<Range>();
         logMsg("%*s range - keyword:%d key:%s min:%f max:%f\n", _indent, "",
                f.keyword != FilterKeyword::undefined,
-               f.key.c_str(), f.min, f.max);
+               f.key.str().c_str(), f.min, f.max);
         return;
     }
     case Data::type<Function>::value: {
@@ -132,16 +132,16 @@ const std::string& Filter::key() const {
     switch (data.get_type_index()) {
 
     case Data::type<Existence>::value:
-        return data.get<Existence>().key;
+        return data.get<Existence>().key.str();
 
     case Data::type<EqualitySet>::value:
-        return data.get<EqualitySet>().key;
+        return data.get<EqualitySet>().key.str();
 
     case Data::type<Equality>::value:
-        return data.get<Equality>().key;
+        return data.get<Equality>().key.str();
 
     case Data::type<Filter::Range>::value:
-        return data.get<Range>().key;
+        return data.get<Range>().key.str();
 
     default:
         break;
@@ -382,4 +382,22 @@ bool Filter::eval(const Feature& feat, StyleContext& ctx) const {
     return Data::visit(data, matcher(feat, ctx));
 }
 
+bool Filter::matchValue(const Value& _value) const {
+
+    switch (data.get_type_index()) {
+    case Data::type<EqualitySet>::value:
+        return Value::visit(_value, match_equal_set{data.get<EqualitySet>().values});
+
+    case Data::type<Equality>::value:
+        return Value::visit(_value, match_equal{data.get<Equality>().value});
+
+    case Data::type<Range>::value:
+        return Value::visit(_value, match_range{data.get<Range>()});
+
+    default:
+        break;
+    }
+    return false;
+}
+
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "util/atom.h"
 #include "util/variant.h"
 
 #include <vector>
@@ -27,24 +28,26 @@ struct Filter {
         std::vector<Filter> operands;
     };
 
+    /* Property keys are interned when the filter is created, so that
+     * matching a feature compares keys by pointer */
     struct EqualitySet {
-        std::string key;
+        Atom key;
         std::vector<Value> values;
         FilterKeyword keyword;
     };
     struct Equality {
-        std::string key;
+        Atom key;
         Value value;
         FilterKeyword keyword;
     };
     struct Range {
-        std::string key;
+        Atom key;
         float min;
         float max;
         FilterKeyword keyword;
     };
     struct Existence {
-        std::string key;
+        Atom key;
         bool exists;
     };
     struct Function {
@@ -66,6 +69,10 @@ struct Filter {
 
     bool eval(const Feature& feat, StyleContext& ctx) const;
 
+    /* Matches @_value, the property or keyword read by an Equality,
+     * EqualitySet or Range filter. Used by FilterProgram. */
+    bool matchValue(const Value& _value) const;
+
     // Create an 'any', 'all', or 'none' filter
     inline static Filter MatchAny(std::vector<Filter> filters) {
         sort(filters);
@@ -82,18 +89,18 @@ struct Filter {
     // Create an 'equality' filter
     inline static Filter MatchEquality(const std::string& k, const std::vector<Value>& vals) {
         if (vals.size() == 1) {
-            return { Equality{ k, vals[0], keywordType(k) }};
+            return { Equality{ Atom::intern(k), vals[0], keywordType(k) }};
         } else {
-            return { EqualitySet{ k, vals, keywordType(k) }};
+            return { EqualitySet{ Atom::intern(k), vals, keywordType(k) }};
         }
     }
     // Create a 'range' filter
     inline static Filter MatchRange(const std::string& k, float min, float max) {
-        return { Range{ k, min, max, keywordType(k) }};
+        return { Range{ Atom::intern(k), min, max, keywordType(k) }};
     }
     // Create an 'existence' filter
     inline static Filter MatchExistence(const std::string& k, bool ex) {
-        return { Existence{ k, ex }};
+        return { Existence{ Atom::intern(k), ex }};
     }
     // Create an 'function' filter with reference to Scene function id
     inline static Filter MatchFunction(uint32_t id) {
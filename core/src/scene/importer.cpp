@@ -64,7 +64,7 @@ Node Importer::applySceneImports(const std::string& scenePath, const std::string
         if (isUrl(path)) {
             progressCounter++;
             startUrlRequest(path,
-                    [&, p = path](std::vector<char>&& rawData) {
+                    [&, p = path](std::vector<char>&& rawData, bool) {
 
                     if (!rawData.empty()) {
                         std::unique_lock<std::mutex> lock(sceneMutex);
@@ -0,0 +1,296 @@
+#include "jsFunction.h"
+
+#include "scene/filters.h"
+
+#include <cctype>
+#include <cstdlib>
+
+namespace Tangram {
+
+namespace JsFunction {
+
+static bool isIdentifierChar(char _c) {
+    return std::isalnum(static_cast<unsigned char>(_c)) || _c == '_' || _c == '$';
+}
+
+static bool isSpace(char _c) {
+    return std::isspace(static_cast<unsigned char>(_c));
+}
+
+bool featureKeys(const std::string& _source, std::vector<std::string>& _keys) {
+    static const std::string feature = "feature";
+
+    size_t pos = 0;
+    while ((pos = _source.find(feature, pos)) != std::string::npos) {
+        size_t start = pos;
+        pos += feature.size();
+
+        if (start > 0 && (isIdentifierChar(_source[start - 1]) || _source[start - 1] == '.')) {
+            continue;
+        }
+        if (pos < _source.size() && isIdentifierChar(_source[pos])) { continue; }
+
+        while (pos < _source.size() && isSpace(_source[pos])) { pos++; }
+
+        if (pos < _source.size() && _source[pos] == '.') {
+            // feature.key
+            size_t begin = ++pos;
+            while (pos < _source.size() && isIdentifierChar(_source[pos])) { pos++; }
+
+            if (pos > begin) {
+                _keys.push_back(_source.substr(begin, pos - begin));
+                continue;
+            }
+        } else if (pos < _source.size() && _source[pos] == '[') {
+            // feature['key'] or feature["key"]
+            pos++;
+            while (pos < _source.size() && isSpace(_source[pos])) { pos++; }
+
+            if (pos < _source.size() && (_source[pos] == '\'' || _source[pos] == '"')) {
+                char quote = _source[pos];
+                size_t begin = ++pos;
+                size_t end = _source.find(quote, begin);
+
+                // The name is a literal only when the bracket closes right
+                // after it, unlike feature['name:' + lang]
+                size_t close = end;
+                if (close != std::string::npos) {
+                    close++;
+                    while (close < _source.size() && isSpace(_source[close])) { close++; }
+                }
+
+                if (close < _source.size() && _source[close] == ']') {
+                    _keys.push_back(_source.substr(begin, end - begin));
+                    pos = close + 1;
+                    continue;
+                }
+            }
+        }
+
+        // The feature object is indexed by a computed name or passed on
+        return false;
+    }
+    return true;
+}
+
+bool isPure(const std::string& _source) {
+    return _source.find("Math.random") == std::string::npos &&
+        _source.find("Date") == std::string::npos;
+}
+
+namespace {
+
+/* Tokens of the subset of JS accepted by translateFilter() */
+struct Lexer {
+
+    enum Type { identifier, string, number, punctuator, end, invalid };
+
+    const std::string& src;
+    size_t pos = 0;
+
+    Type type = invalid;
+    std::string text;
+
+    Lexer(const std::string& _src) : src(_src) { next(); }
+
+    void next() {
+        while (pos < src.size() && isSpace(src[pos])) { pos++; }
+
+        text.clear();
+
+        if (pos >= src.size()) {
+            type = end;
+            return;
+        }
+
+        char c = src[pos];
+
+        if (isIdentifierChar(c) && !std::isdigit(static_cast<unsigned char>(c))) {
+            size_t begin = pos;
+            while (pos < src.size() && isIdentifierChar(src[pos])) { pos++; }
+            type = identifier;
+            text = src.substr(begin, pos - begin);
+
+        } else if (std::isdigit(static_cast<unsigned char>(c))) {
+            size_t begin = pos;
+            while (pos < src.size() && (std::isdigit(static_cast<unsigned char>(src[pos])) || src[pos] == '.')) {
+                pos++;
+            }
+            type = number;
+            text = src.substr(begin, pos - begin);
+
+        } else if (c == '\'' || c == '"') {
+            size_t end = src.find(c, pos + 1);
+            if (end == std::string::npos || src.find('\\', pos + 1) < end) {
+                // Escapes are not translated
+                type = invalid;
+                return;
+            }
+            type = string;
+            text = src.substr(pos + 1, end - pos - 1);
+            pos = end + 1;
+
+        } else if (src.compare(pos, 3, "===") == 0 || src.compare(pos, 3, "!==") == 0) {
+            type = punctuator;
+            text = src.substr(pos, 3);
+            pos += 3;
+
+        } else if (src.compare(pos, 2, "&&") == 0 || src.compare(pos, 2, "||") == 0) {
+            type = punctuator;
+            text = src.substr(pos, 2);
+            pos += 2;
+
+        } else if (std::string("(){}[];.-").find(c) != std::string::npos &&
+                   src.compare(pos, 2, "//") != 0 && src.compare(pos, 2, "/*") != 0) {
+            type = punctuator;
+            text = std::string(1, c);
+            pos++;
+
+        } else {
+            type = invalid;
+        }
+    }
+
+    bool accept(Type _type, const char* _text) {
+        if (type != _type || text != _text) { return false; }
+        next();
+        return true;
+    }
+};
+
+struct Translator {
+
+    Lexer lex;
+
+    Translator(const std::string& _source) : lex(_source) {}
+
+    bool function(Filter& _filter) {
+        if (!lex.accept(Lexer::identifier, "function")) { return false; }
+        if (!lex.accept(Lexer::punctuator, "(")) { return false; }
+        if (!lex.accept(Lexer::punctuator, ")")) { return false; }
+        if (!lex.accept(Lexer::punctuator, "{")) { return false; }
+        if (!lex.accept(Lexer::identifier, "return")) { return false; }
+
+        if (!anyOf(_filter)) { return false; }
+
+        lex.accept(Lexer::punctuator, ";");
+
+        if (!lex.accept(Lexer::punctuator, "}")) { return false; }
+        return lex.type == Lexer::end;
+    }
+
+    // a || b || ...
+    bool anyOf(Filter& _filter) {
+        std::vector<Filter> operands(1);
+        if (!allOf(operands.back())) { return false; }
+
+        while (lex.accept(Lexer::punctuator, "||")) {
+            operands.emplace_back();
+            if (!allOf(operands.back())) { return false; }
+        }
+
+        _filter = operands.size() == 1 ? std::move(operands[0]) : Filter::MatchAny(std::move(operands));
+        return true;
+    }
+
+    // a && b && ...
+    bool allOf(Filter& _filter) {
+        std::vector<Filter> operands(1);
+        if (!comparison(operands.back())) { return false; }
+
+        while (lex.accept(Lexer::punctuator, "&&")) {
+            operands.emplace_back();
+            if (!comparison(operands.back())) { return false; }
+        }
+
+        _filter = operands.size() == 1 ? std::move(operands[0]) : Filter::MatchAll(std::move(operands));
+        return true;
+    }
+
+    // (expr), feature.key === literal or literal === feature.key
+    bool comparison(Filter& _filter) {
+        if (lex.accept(Lexer::punctuator, "(")) {
+            return anyOf(_filter) && lex.accept(Lexer::punctuator, ")");
+        }
+
+        std::string key;
+        std::string op;
+        Value value;
+
+        if (lex.type == Lexer::identifier) {
+            if (!property(key) || !strictOperator(op) || !literal(value)) { return false; }
+        } else {
+            if (!literal(value) || !strictOperator(op) || !property(key)) { return false; }
+        }
+
+        _filter = Filter::MatchEquality(key, { value });
+        if (op == "!==") {
+            _filter = Filter::MatchNone({ std::move(_filter) });
+        }
+        return true;
+    }
+
+    bool property(std::string& _key) {
+        if (!lex.accept(Lexer::identifier, "feature")) { return false; }
+
+        if (lex.accept(Lexer::punctuator, ".")) {
+            if (lex.type != Lexer::identifier) { return false; }
+            _key = lex.text;
+            lex.next();
+        } else if (lex.accept(Lexer::punctuator, "[")) {
+            if (lex.type != Lexer::string) { return false; }
+            _key = lex.text;
+            lex.next();
+            if (!lex.accept(Lexer::punctuator, "]")) { return false; }
+        } else {
+            return false;
+        }
+
+        // Native filters read keys starting with '$' as keywords
+        return !_key.empty() && _key[0] != '$';
+    }
+
+    bool strictOperator(std::string& _op) {
+        if (lex.type != Lexer::punctuator || (lex.text != "===" && lex.text != "!==")) {
+            return false;
+        }
+        _op = lex.text;
+        lex.next();
+        return true;
+    }
+
+    bool literal(Value& _value) {
+        bool negative = lex.accept(Lexer::punctuator, "-");
+
+        if (lex.type == Lexer::number) {
+            char* end = nullptr;
+            double number = std::strtod(lex.text.c_str(), &end);
+            if (*end != '\0') { return false; }
+            _value = Value(negative ? -number : number);
+            lex.next();
+            return true;
+        }
+        if (lex.type == Lexer::string && !negative) {
+            _value = Value(lex.text);
+            lex.next();
+            return true;
+        }
+        return false;
+    }
+};
+
+}
+
+bool translateFilter(const std::string& _source, Filter& _filter) {
+    Filter filter;
+    Translator translator(_source);
+
+    if (!translator.function(filter)) { return false; }
+
+    _filter = std::move(filter);
+    return true;
+}
+
+}
+
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Tangram {
+
+struct Filter;
+
+/* Static analysis of the JS functions of a scene */
+namespace JsFunction {
+
+    /* Appends to @_keys the feature properties that @_source reads as
+     * 'feature.key' or feature['key']. Returns false when the function
+     * indexes 'feature' by a computed name or passes it on, so that it may
+     * read any property. */
+    bool featureKeys(const std::string& _source, std::vector<std::string>& _keys);
+
+    /* Whether the result of @_source depends only on the feature, the
+     * keywords and the scene globals: false when it reads the clock or
+     * random numbers. */
+    bool isPure(const std::string& _source);
+
+    /* Translates a filter function of the form
+     *   function() { return <expr>; }
+     * where <expr> combines strict comparisons of feature properties with
+     * string or number literals ('===', '!==') by '&&', '||' and
+     * parentheses, into the equivalent native @_filter.
+     * Returns false, leaving @_filter unchanged, for any other function. */
+    bool translateFilter(const std::string& _source, Filter& _filter);
+
+}
+
+}
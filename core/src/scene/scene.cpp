@@ -4,6 +4,7 @@
 #include "gl/shaderProgram.h"
 #include "platform.h"
 #include "scene/dataLayer.h"
+#include "scene/decodePlan.h"
 #include "scene/light.h"
 #include "scene/spriteAtlas.h"
 #include "scene/stops.h"
@@ -125,4 +126,19 @@ std::shared_ptr<DataSource> Scene::getDataSource(const std::string& name) {
     return nullptr;
 }
 
+void Scene::buildDecodePlans() {
+    m_decodePlans.clear();
+
+    for (auto& source : m_dataSources) {
+        m_decodePlans[source->name()] = std::make_unique<DecodePlan>(*this, source->name());
+    }
+}
+
+const DecodePlan* Scene::decodePlan(const std::string& _name) const {
+    auto it = m_decodePlans.find(_name);
+    if (it == m_decodePlans.end()) { return nullptr; }
+
+    return it->second.get();
+}
+
 }
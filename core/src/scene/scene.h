@@ -20,6 +20,7 @@ class Style;
 class Texture;
 class DataSource;
 class DataLayer;
+class DecodePlan;
 class FontContext;
 class Light;
 class MapProjection;
@@ -106,6 +107,13 @@ public:
 
     std::shared_ptr<DataSource> getDataSource(const std::string& name);
 
+    /* Computes the DecodePlan of each data source, once the layers, styles
+     * and functions are loaded */
+    void buildDecodePlans();
+
+    /* Tile data of source @_name read by this scene, nullptr when unknown */
+    const DecodePlan* decodePlan(const std::string& _name) const;
+
     std::shared_ptr<Texture> getTexture(const std::string& name) const;
 
     float pixelScale() { return m_pixelScale; }
@@ -141,6 +149,8 @@ private:
     std::vector<std::string> m_jsFunctions;
     std::list<Stops> m_stops;
 
+    fastmap<std::string, std::unique_ptr<DecodePlan>> m_decodePlans;
+
     Color m_background;
 
     std::shared_ptr<FontContext> m_fontContext;
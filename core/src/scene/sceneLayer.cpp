@@ -1,5 +1,7 @@
 #include "sceneLayer.h"
 
+#include "scene/filterProgram.h"
+
 #include <algorithm>
 
 namespace Tangram {
@@ -18,6 +20,10 @@ SceneLayer::SceneLayer(std::string _name, Filter _filter,
 
 }
 
+void SceneLayer::compileFilters() {
+    m_filterProgram = std::make_shared<FilterProgram>(*this);
+}
+
 void SceneLayer::setDepth(size_t _d) {
 
     m_depth = _d;
@@ -4,12 +4,14 @@
 #include "scene/filters.h"
 #include "scene/styleParam.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace Tangram {
 
 struct Feature;
+class FilterProgram;
 
 class SceneLayer {
 
@@ -20,6 +22,12 @@ class SceneLayer {
     size_t m_depth = 0;
     bool m_visible;
 
+    // Filters of this layer tree, set on the root of the tree only
+    std::shared_ptr<const FilterProgram> m_filterProgram;
+    size_t m_filterId = 0;
+
+    friend class FilterProgram;
+
 public:
 
     SceneLayer(std::string _name, Filter _filter,
@@ -34,7 +42,18 @@ public:
     const auto& depth() const { return m_depth; }
     const auto& visible() const { return m_visible; }
 
+    /* The compiled filters of the tree, set on DataLayers only */
+    const FilterProgram* filterProgram() const { return m_filterProgram.get(); }
+    /* Index of the filter of this layer in the FilterProgram of its root */
+    size_t filterId() const { return m_filterId; }
+
     void setDepth(size_t _d);
+
+protected:
+
+    /* Compiles the filters of this layer tree into the FilterProgram of
+     * this layer, done once for each root */
+    void compileFilters();
 };
 
 }
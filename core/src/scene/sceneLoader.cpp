@@ -19,6 +19,7 @@
 #include "scene/dataLayer.h"
 #include "scene/filters.h"
 #include "scene/importer.h"
+#include "scene/jsFunction.h"
 #include "scene/sceneLayer.h"
 #include "scene/spriteAtlas.h"
 #include "scene/stops.h"
@@ -276,6 +277,8 @@ bool SceneLoader::applyConfig(Node& config, Scene& _scene) {
         style->build(_scene);
     }
 
+    _scene.buildDecodePlans();
+
     return true;
 }
 
@@ -538,7 +541,7 @@ std::shared_ptr<Texture> SceneLoader::fetchTexture(const std::string& name, cons
     // TODO: generalize using URI handlers
     if (std::regex_search(url, match, r)) {
         scene.m_resourceLoad++;
-        startUrlRequest(url, [=, &scene](std::vector<char>&& rawData) {
+        startUrlRequest(url, [=, &scene](std::vector<char>&& rawData, bool) {
                 auto ptr = (unsigned char*)(rawData.data());
                 size_t dataSize = rawData.size();
                 std::lock_guard<std::mutex> lock(m_textureMutex);
@@ -886,6 +889,40 @@ void SceneLoader::loadSource(const std::string& name, const Node& source, const
 
     if (sourcePtr) {
         sourcePtr->setCacheSize(CACHE_SIZE);
+
+        // Concurrent requests: a fixed number or 'auto' to adapt to the network
+        if (auto maxDownloadsNode = source["max_downloads"]) {
+            if (maxDownloadsNode.Scalar() == "auto") {
+                sourcePtr->setAdaptiveDownloads(1, DownloadBudget::MAX_ADAPTIVE_LIMIT);
+            } else {
+                int maxDownloads = maxDownloadsNode.as<int>(0);
+                if (maxDownloads > 0) {
+                    sourcePtr->setMaxDownloads(maxDownloads);
+                } else {
+                    LOGW("Invalid max_downloads in source '%s'", name.c_str());
+                }
+            }
+        }
+
+        // Tolerance in pixels for simplifying lines and polygons
+        if (auto simplifyNode = source["simplify"]) {
+            float tolerance = simplifyNode.as<float>(0.f);
+            if (tolerance > 0.f) {
+                sourcePtr->setSimplifyTolerance(tolerance);
+            } else {
+                LOGW("Invalid simplify in source '%s'", name.c_str());
+            }
+        }
+
+        // Megabytes of polygon triangulations kept for tile rebuilds
+        if (auto tessellationCacheNode = source["tessellation_cache"]) {
+            int cacheSize = tessellationCacheNode.as<int>(0);
+            if (cacheSize > 0) {
+                sourcePtr->setTessellationCacheSize(size_t(cacheSize) * (1024 * 1024));
+            } else {
+                LOGW("Invalid tessellation_cache in source '%s'", name.c_str());
+            }
+        }
         _scene.dataSources().push_back(sourcePtr);
     }
 
@@ -1135,6 +1172,10 @@ Filter SceneLoader::generateFilter(Node _filter, Scene& scene) {
         const std::string& val = _filter.Scalar();
 
         if (val.compare(0, 8, "function") == 0) {
+            // Simple comparisons of feature properties run natively
+            Filter native;
+            if (JsFunction::translateFilter(val, native)) { return native; }
+
             scene.functions().push_back(val);
             return Filter::MatchFunction(scene.functions().size()-1);
         }
@@ -4,11 +4,16 @@
 #include "data/propertyItem.h"
 #include "data/tileData.h"
 #include "scene/filters.h"
+#include "scene/jsFunction.h"
 #include "scene/scene.h"
 #include "util/builders.h"
+#include "util/hash.h"
 
 #include "duktape.h"
 
+// Maximum number of function results cached between keyword changes
+#define MAX_CACHED_RESULTS 512
+
 #define DUMP(...) // do { logMsg(__VA_ARGS__); duk_dump_context_stderr(m_ctx); } while(0)
 #define DBG(...) do { logMsg(__VA_ARGS__); duk_dump_context_stderr(m_ctx); } while(0)
 
@@ -154,6 +159,8 @@ void StyleContext::setSceneGlobals(const std::unordered_map<std::string, YAML::N
     }
 
     duk_put_global_string(m_ctx, "global");
+
+    clearResults();
 }
 
 void StyleContext::initFunctions(const Scene& _scene) {
@@ -174,7 +181,22 @@ bool StyleContext::setFunctions(const std::vector<std::string>& _functions) {
 
     bool ok = true;
 
+    clearResults();
+    m_functionKeys.assign(_functions.size(), {});
+    m_cacheable.assign(_functions.size(), false);
+
     for (auto& function : _functions) {
+
+        // Results of a pure function that reads only named properties
+        // can be reused for features with the same values of these
+        std::vector<std::string> keys;
+        if (JsFunction::isPure(function) && JsFunction::featureKeys(function, keys)) {
+            m_cacheable[id] = true;
+            for (const auto& key : keys) {
+                m_functionKeys[id].push_back(Atom::intern(key));
+            }
+        }
+
         duk_push_string(m_ctx, function.c_str());
         duk_push_string(m_ctx, "");
 
@@ -230,6 +252,9 @@ void StyleContext::setKeyword(const std::string& _key, Value _val) {
     Value& entry = m_keywords[static_cast<uint8_t>(keywordKey)];
     if (entry == _val) { return; }
 
+    // Cached results are keyed by $geometry but not by the other keywords
+    if (keywordKey != FilterKeyword::geometry) { clearResults(); }
+
     if (_val.is<std::string>()) {
         duk_push_string(m_ctx, _val.get<std::string>().c_str());
         duk_put_global_string(m_ctx, _key.c_str());
@@ -278,8 +303,70 @@ bool StyleContext::evalFunction(FunctionID id) {
     return true;
 }
 
+const StyleContext::CachedResult* StyleContext::findResult(FunctionID _id, int _key, size_t& _hash) {
+
+    if (!m_feature || _id >= m_cacheable.size() || !m_cacheable[_id]) { return nullptr; }
+
+    const auto& keys = m_functionKeys[_id];
+    const Value& geometry = getKeyword(FilterKeyword::geometry);
+
+    m_signature.clear();
+    for (auto key : keys) { m_signature.push_back(&m_feature->props.get(key)); }
+
+    size_t hash = 0;
+    hash_combine(hash, _id);
+    hash_combine(hash, _key);
+    hash_combine(hash, Value::visit(geometry, value_hash{}));
+    for (auto* value : m_signature) {
+        hash_combine(hash, Value::visit(*value, value_hash{}));
+    }
+    _hash = hash;
+
+    auto it = m_results.find(hash);
+    if (it == m_results.end()) { return nullptr; }
+
+    for (const auto& entry : it->second) {
+        if (entry.id != _id || entry.key != _key || entry.geometry != geometry) { continue; }
+
+        bool equal = true;
+        for (size_t i = 0; i < keys.size() && equal; i++) {
+            equal = entry.values[i] == *m_signature[i];
+        }
+        if (equal) {
+            m_resultHits++;
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+void StyleContext::storeResult(size_t _hash, FunctionID _id, int _key, bool _result,
+                               const StyleParam::Value& _value) {
+
+    if (!m_feature || _id >= m_cacheable.size() || !m_cacheable[_id]) { return; }
+    if (m_resultsSize >= MAX_CACHED_RESULTS) { return; }
+
+    std::vector<Value> values;
+    values.reserve(m_signature.size());
+    for (auto* value : m_signature) { values.push_back(*value); }
+
+    m_results[_hash].push_back({ _id, _key, getKeyword(FilterKeyword::geometry),
+                                 std::move(values), _result, _value });
+    m_resultsSize++;
+}
+
+void StyleContext::clearResults() {
+    m_results.clear();
+    m_resultsSize = 0;
+}
+
 bool StyleContext::evalFilter(FunctionID _id) {
 
+    size_t hash = 0;
+    if (auto* cached = findResult(_id, -1, hash)) {
+        return cached->result;
+    }
+
     bool result = false;
 
     if (!evalFunction(_id)) { return false; };
@@ -292,11 +379,19 @@ bool StyleContext::evalFilter(FunctionID _id) {
     // pop result
     duk_pop(m_ctx);
 
+    storeResult(hash, _id, -1, result, none_type{});
+
     return result;
 }
 
 bool StyleContext::evalStyle(FunctionID _id, StyleParamKey _key, StyleParam::Value& _val) {
 
+    size_t hash = 0;
+    if (auto* cached = findResult(_id, static_cast<int>(_key), hash)) {
+        _val = cached->value;
+        return cached->result;
+    }
+
     if (!evalFunction(_id)) { return false; }
 
     // parse evaluated result at stack top
@@ -305,7 +400,11 @@ bool StyleContext::evalStyle(FunctionID _id, StyleParamKey _key, StyleParam::Val
     // pop result, empty stack
     duk_pop(m_ctx);
 
-    return !_val.is<none_type>();
+    bool result = !_val.is<none_type>();
+
+    storeResult(hash, _id, static_cast<int>(_key), result, _val);
+
+    return result;
 }
 
 void StyleContext::parseStyleResult(StyleParamKey _key, StyleParam::Value& _val) const {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "scene/styleParam.h"
+#include "util/atom.h"
 #include "util/fastmap.h"
 
 #include <string>
@@ -8,6 +9,7 @@
 #include <memory>
 #include <array>
 #include <unordered_map>
+#include <vector>
 
 struct duk_hthread;
 typedef struct duk_hthread duk_context;
@@ -74,7 +76,25 @@ public:
     void setKeyword(const std::string& _key, Value _value);
     const Value& getKeyword(const std::string& _key) const;
 
+    /* Number of function calls answered from the result cache */
+    size_t resultHits() const { return m_resultHits; }
+
 private:
+    /* Result of a function for one combination of the feature properties
+     * it reads. Filters have no StyleParamKey and store @key -1 */
+    struct CachedResult {
+        FunctionID id;
+        int key;
+        Value geometry;
+        std::vector<Value> values;
+        bool result;
+        StyleParam::Value value;
+    };
+
+    const CachedResult* findResult(FunctionID _id, int _key, size_t& _hash);
+    void storeResult(size_t _hash, FunctionID _id, int _key, bool _result, const StyleParam::Value& _value);
+    void clearResults();
+
     static int jsGetProperty(duk_context *_ctx);
     static int jsHasProperty(duk_context *_ctx);
 
@@ -90,6 +110,16 @@ private:
 
     const Feature* m_feature = nullptr;
 
+    // Feature properties read by each pure function; empty for functions
+    // whose results are not cached
+    std::vector<std::vector<Atom>> m_functionKeys;
+    std::vector<bool> m_cacheable;
+
+    std::unordered_map<size_t, std::vector<CachedResult>> m_results;
+    std::vector<const Value*> m_signature;
+    size_t m_resultsSize = 0;
+    size_t m_resultHits = 0;
+
     mutable duk_context *m_ctx;
 };
 
@@ -69,6 +69,9 @@ struct DebugStyleBuilder : public StyleBuilder {
         return std::move(mesh);
     }
 
+    // Tile bounds do not depend on features
+    void merge(StyleBuilder& _other) override {}
+
     const Style& style() const override { return m_style; }
 
     DebugStyleBuilder(const DebugStyle& _style)
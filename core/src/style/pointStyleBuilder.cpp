@@ -42,24 +42,27 @@ std::unique_ptr<StyledMesh> PointStyleBuilder::build() {
         m_iconMesh->setLabels(m_labels);
 
     } else {
-        size_t sumLabels = 0;
+        // Move the labels that are alive and their quads to the front of
+        // m_labels and m_quads, which keep their storage for the next tile
+        size_t numLabels = 0;
 
-        // Determine number of labels
-       for (auto& label : m_labels) {
-           if (label->state() != Label::State::dead) { sumLabels +=1; }
-        }
+        for (auto& label : m_labels) {
+            if (label->state() == Label::State::dead) { continue; }
+
+            auto* spriteLabel = static_cast<SpriteLabel*>(label.get());
+            m_quads[numLabels] = m_quads[spriteLabel->quadIndex()];
+            spriteLabel->setQuadIndex(numLabels);
 
-       std::vector<std::unique_ptr<Label>> labels;
-       labels.reserve(sumLabels);
+            auto& live = m_labels[numLabels++];
+            if (&live != &label) { live = std::move(label); }
+        }
+        m_labels.resize(numLabels);
+        m_quads.resize(numLabels);
 
-       for (auto& label : m_labels) {
-           if (label->state() != Label::State::dead) {
-               labels.push_back(std::move(label));
-           }
-       }
-       m_iconMesh->setLabels(labels);
+        m_iconMesh->setLabels(m_labels);
     }
 
+    // The tile keeps an exact-size copy
     std::vector<SpriteQuad> quads(m_quads);
     m_spriteLabels->setQuads(std::move(quads));
 
@@ -75,6 +78,25 @@ std::unique_ptr<StyledMesh> PointStyleBuilder::build() {
     return std::move(m_iconMesh);
 }
 
+void PointStyleBuilder::merge(StyleBuilder& _other) {
+    auto& other = static_cast<PointStyleBuilder&>(_other);
+
+    size_t quadOffset = m_quads.size();
+
+    for (auto& label : other.m_labels) {
+        static_cast<SpriteLabel*>(label.get())->relocate(*m_spriteLabels, quadOffset);
+    }
+    m_labels.insert(m_labels.end(),
+                    std::make_move_iterator(other.m_labels.begin()),
+                    std::make_move_iterator(other.m_labels.end()));
+    other.m_labels.clear();
+
+    m_quads.insert(m_quads.end(), other.m_quads.begin(), other.m_quads.end());
+    other.m_quads.clear();
+
+    m_textStyleBuilder->merge(*other.m_textStyleBuilder);
+}
+
 void PointStyleBuilder::setup(const Tile& _tile) {
     m_zoom = _tile.getID().z;
     m_spriteLabels = std::make_unique<SpriteLabels>(m_style);
@@ -31,6 +31,8 @@ struct PointStyleBuilder : public StyleBuilder {
 
     std::unique_ptr<StyledMesh> build() override;
 
+    void merge(StyleBuilder& _other) override;
+
     const Style& style() const override { return m_style; }
 
     PointStyleBuilder(const PointStyle& _style) : StyleBuilder(_style), m_style(_style) {
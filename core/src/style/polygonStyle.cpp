@@ -98,12 +98,20 @@ public:
         m_meshData.clear();
     }
 
+    void setTessellationCache(TessellationCache* _cache) override {
+        m_builder.cache = _cache;
+    }
+
     void addPolygon(const Polygon& _polygon, const Properties& _props, const DrawRule& _rule) override;
 
     const Style& style() const override { return m_style; }
 
     std::unique_ptr<StyledMesh> build() override;
 
+    void merge(StyleBuilder& _other) override {
+        m_meshData.append(static_cast<PolygonStyleBuilder<V>&>(_other).m_meshData);
+    }
+
     PolygonStyleBuilder(const PolygonStyle& _style) : StyleBuilder(_style), m_style(_style) {}
 
     void parseRule(const DrawRule& _rule, const Properties& _props);
@@ -156,18 +164,18 @@ void PolygonStyleBuilder<V>::addPolygon(const Polygon& _polygon, const Propertie
 
     parseRule(_rule, _props);
 
-    m_builder.addVertex = [this](const glm::vec3& coord,
-                                 const glm::vec3& normal,
-                                 const glm::vec2& uv) {
+    auto addVertex = [this](const glm::vec3& coord,
+                            const glm::vec3& normal,
+                            const glm::vec2& uv) {
         m_meshData.vertices.push_back({ coord, m_params.order, normal, uv, m_params.color });
     };
 
     if (m_params.minHeight != m_params.height) {
         Builders::buildPolygonExtrusion(_polygon, m_params.minHeight,
-                                        m_params.height, m_builder);
+                                        m_params.height, m_builder, addVertex);
     }
 
-    Builders::buildPolygon(_polygon, m_params.height, m_builder);
+    Builders::buildPolygon(_polygon, m_params.height, m_builder, addVertex);
 
     m_meshData.indices.insert(m_meshData.indices.end(),
                               m_builder.indices.begin(),
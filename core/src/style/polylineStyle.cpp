@@ -167,6 +167,13 @@ public:
 
     std::unique_ptr<StyledMesh> build() override;
 
+    void merge(StyleBuilder& _other) override {
+        auto& other = static_cast<PolylineStyleBuilder<V>&>(_other);
+        for (size_t i = 0; i < m_meshData.size(); i++) {
+            m_meshData[i].append(other.m_meshData[i]);
+        }
+    }
+
     PolylineStyleBuilder(const PolylineStyle& _style)
         : StyleBuilder(_style), m_style(_style),
           m_meshData(2) {}
@@ -400,12 +407,14 @@ void PolylineStyleBuilder<V>::buildLine(const Line& _line, const typename Parame
                         MeshData<V>& _mesh) {
 
     float zoom = m_overzoom2;
-    m_builder.addVertex = [&](const glm::vec3& coord, const glm::vec2& normal, const glm::vec2& uv) {
-        _mesh.vertices.push_back({{ coord.x,coord.y }, normal, { uv.x, uv.y * zoom },
-                                  _att.width, _att.height, _att.color});
-    };
 
-    Builders::buildPolyLine(_line, m_builder);
+    // Vertices are emitted directly into the typed mesh, the lambda inlines
+    // into the builder
+    Builders::buildPolyLine(_line, m_builder,
+        [&](const glm::vec3& coord, const glm::vec2& normal, const glm::vec2& uv) {
+            _mesh.vertices.push_back({{ coord.x,coord.y }, normal, { uv.x, uv.y * zoom },
+                                      _att.width, _att.height, _att.color});
+        });
 
     _mesh.indices.insert(_mesh.indices.end(),
                          m_builder.indices.begin(),
@@ -439,7 +448,10 @@ void PolylineStyleBuilder<V>::addMesh(const Line& _line, const Parameters& _para
         m_builder.join = _params.stroke.join;
         m_builder.miterLimit = _params.stroke.miterLimit;
 
+        // Segment normals and lengths are still those of the fill pass
+        m_builder.reuseSegments = _params.lineOn;
         buildLine(_line, _params.stroke, m_meshData[1]);
+        m_builder.reuseSegments = false;
 
     } else {
         auto& fill = m_meshData[0];
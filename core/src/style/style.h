@@ -4,6 +4,7 @@
 #include "gl/uniform.h"
 #include "util/fastmap.h"
 #include "data/tileData.h"
+#include "util/memoryUsage.h"
 
 #include <memory>
 #include <string>
@@ -26,6 +27,7 @@ class Scene;
 class ShaderProgram;
 class Style;
 class DataSource;
+class TessellationCache;
 
 enum class LightingType : char {
     none,
@@ -52,6 +54,13 @@ struct StyledMesh {
     virtual bool draw(ShaderProgram& _shader) = 0;
     virtual size_t bufferSize() const = 0;
 
+    /* Adds the memory held by this mesh to @_usage */
+    virtual void addMemoryUsage(MemoryUsage& _usage) const { _usage.gpuBuffers += bufferSize(); }
+
+    /* Number of compiled vertices and indices, zero for label sets */
+    virtual size_t numVertices() const { return 0; }
+    virtual size_t numIndices() const { return 0; }
+
     virtual ~StyledMesh() {}
 };
 
@@ -64,6 +73,10 @@ public:
 
     virtual void setup(const Tile& _tile) = 0;
 
+    /* Cache for the triangulations of polygons of the DataSource of the
+     * current tile, nullptr when it is disabled */
+    virtual void setTessellationCache(TessellationCache* _cache) {}
+
     virtual void addFeature(const Feature& _feat, const DrawRule& _rule);
 
     /* Build styled vertex data for point geometry */
@@ -78,6 +91,10 @@ public:
     /* Create a new mesh object using the vertex layout corresponding to this style */
     virtual std::unique_ptr<StyledMesh> build() = 0;
 
+    /* Move the data collected by @_other, a builder of the same style, behind
+     * the data of this builder */
+    virtual void merge(StyleBuilder& _other) = 0;
+
     virtual bool checkRule(const DrawRule& _rule) const;
 
     virtual void addLayoutItems(LabelCollider& _layout) {}
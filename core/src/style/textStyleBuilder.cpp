@@ -13,6 +13,7 @@
 #include "view/view.h"
 #include "tangram.h"
 
+#include <algorithm>
 #include <cmath>
 #include <locale>
 #include <mutex>
@@ -20,7 +21,7 @@
 
 namespace Tangram {
 
-const static std::string key_name("name");
+const static Atom key_name = Atom::intern("name");
 
 
 TextStyleBuilder::TextStyleBuilder(const TextStyle& _style)
@@ -46,6 +47,28 @@ void TextStyleBuilder::addLayoutItems(LabelCollider& _layout) {
     _layout.addLabels(m_labels);
 }
 
+void TextStyleBuilder::merge(StyleBuilder& _other) {
+    auto& other = static_cast<TextStyleBuilder&>(_other);
+
+    int quadOffset = m_quads.size();
+
+    for (auto& label : other.m_labels) {
+        static_cast<TextLabel*>(label.get())->relocate(*m_textLabels, quadOffset);
+    }
+    m_labels.insert(m_labels.end(),
+                    std::make_move_iterator(other.m_labels.begin()),
+                    std::make_move_iterator(other.m_labels.end()));
+    other.m_labels.clear();
+
+    m_quads.insert(m_quads.end(), other.m_quads.begin(), other.m_quads.end());
+    other.m_quads.clear();
+
+    // Both builders hold a reference on the atlases they share
+    m_style.context()->releaseAtlas(m_atlasRefs & other.m_atlasRefs);
+    m_atlasRefs |= other.m_atlasRefs;
+    other.m_atlasRefs.reset();
+}
+
 std::unique_ptr<StyledMesh> TextStyleBuilder::build() {
 
     if (m_quads.empty()) { return nullptr; }
@@ -58,45 +81,14 @@ std::unique_ptr<StyledMesh> TextStyleBuilder::build() {
 
     } else {
 
-        // TODO this could probably done more elegant
-
+        // Move the quads and labels that are alive to the front of m_quads
+        // and m_labels, which keep their storage for the next tile
         int quadPos = 0;
-        size_t sumQuads = 0;
-        size_t sumLabels = 0;
         bool added = false;
-
-        // Determine number of labels and size of final quads vector
-        for (auto& label : m_labels) {
-            auto* textLabel = static_cast<TextLabel*>(label.get());
-
-            auto& range = textLabel->quadRange();
-            bool active = textLabel->state() != Label::State::dead;
-
-            if (range.end() != quadPos) {
-                quadPos = range.end();
-                added = false;
-            }
-
-            if (!active) { continue; }
-
-            sumLabels +=1;
-            if (!added) {
-                added = true;
-                sumQuads += range.length;
-            }
-        }
-
         size_t quadEnd = 0;
         size_t quadStart = 0;
-        quadPos = 0;
-
-        std::vector<std::unique_ptr<Label>> labels;
-        labels.reserve(sumLabels);
+        size_t numLabels = 0;
 
-        std::vector<GlyphQuad> quads;
-        quads.reserve(sumQuads);
-
-        // Add only alive labels
         for (auto& label : m_labels) {
             auto* textLabel = static_cast<TextLabel*>(label.get());
 
@@ -112,17 +104,26 @@ std::unique_ptr<StyledMesh> TextStyleBuilder::build() {
             if (!active) { continue; }
             if (!added) {
                 added = true;
-                quadEnd += range.length;
 
-                auto it = m_quads.begin() + range.start;
-                quads.insert(quads.end(), it, it + range.length);
+                // Ranges follow each other, so this never overwrites quads
+                // that are still to be moved
+                if (quadEnd != size_t(range.start)) {
+                    auto it = m_quads.begin() + range.start;
+                    std::copy(it, it + range.length, m_quads.begin() + quadEnd);
+                }
+                quadEnd += range.length;
             }
             range.start = quadStart;
 
-            labels.push_back(std::move(label));
+            auto& live = m_labels[numLabels++];
+            if (&live != &label) { live = std::move(label); }
         }
+        m_labels.resize(numLabels);
+        m_quads.resize(quadEnd);
 
-        m_textLabels->setLabels(labels);
+        // The tile keeps an exact-size copy
+        std::vector<GlyphQuad> quads(m_quads);
+        m_textLabels->setLabels(m_labels);
         m_textLabels->setQuads(std::move(quads), m_atlasRefs);
     }
 
@@ -30,6 +30,8 @@ public:
 
     std::unique_ptr<StyledMesh> build() override;
 
+    void merge(StyleBuilder& _other) override;
+
     TextStyle::Parameters applyRule(const DrawRule& _rule, const Properties& _props, bool _iconText) const;
 
     bool prepareLabel(TextStyle::Parameters& _params, Label::Type _type);
@@ -19,6 +19,7 @@
 #include "util/fastmap.h"
 #include "view/view.h"
 #include "data/clientGeoJsonSource.h"
+#include "data/diskCache.h"
 #include "gl.h"
 #include "gl/hardware.h"
 #include "util/ease.h"
@@ -46,6 +47,7 @@ std::shared_ptr<Scene> m_scene;
 std::shared_ptr<View> m_view;
 std::unique_ptr<Labels> m_labels;
 std::unique_ptr<InputHandler> m_inputHandler;
+std::shared_ptr<DiskCache> m_diskCache;
 
 std::shared_ptr<Scene> m_nextScene;
 std::vector<Scene::Update> m_sceneUpdates;
@@ -60,6 +62,35 @@ void clearEase(EaseField _f) {
     static Ease none = {};
     m_eases[static_cast<size_t>(_f)] = none;
 }
+bool isEasing(EaseField _f) {
+    return !m_eases[static_cast<size_t>(_f)].finished();
+}
+
+// Destinations of position and zoom eases, used for tile prefetching
+glm::dvec2 m_easeTargetPosition;
+float m_easeTargetZoom = 0;
+
+// Collect tiles along the predicted camera path: the rest point of a fling
+// or the destination of running position and zoom eases.
+void getPrefetchTiles(std::set<TileID>& _tiles) {
+    glm::dvec2 position(m_view->getPosition());
+    float zoom = m_view->getZoom();
+
+    bool predicted = m_inputHandler->getFlingTarget(position, zoom);
+
+    if (isEasing(EaseField::position)) {
+        position = m_easeTargetPosition;
+        predicted = true;
+    }
+    if (isEasing(EaseField::zoom)) {
+        zoom = m_easeTargetZoom;
+        predicted = true;
+    }
+
+    if (predicted) {
+        m_view->getPrefetchTiles(position, zoom, _tiles);
+    }
+}
 
 static float g_time = 0.0;
 static std::bitset<8> g_flags = 0;
@@ -138,6 +169,10 @@ void setScene(std::shared_ptr<Scene>& _scene) {
     }
 
     m_inputHandler->setView(m_view);
+
+    for (auto& source : _scene->dataSources()) {
+        source->setDiskCache(m_diskCache);
+    }
     m_tileManager->setDataSources(_scene->dataSources());
     m_tileWorker->setScene(_scene);
     setPixelScale(m_view->pixelScale());
@@ -293,6 +328,9 @@ bool update(float _dt) {
     m_inputHandler->update(_dt);
     m_view->update();
 
+    std::set<TileID> prefetchTiles;
+    getPrefetchTiles(prefetchTiles);
+
     for (const auto& style : m_scene->styles()) {
         style->onBeginUpdate();
     }
@@ -306,7 +344,7 @@ bool update(float _dt) {
             m_view->getZoom()
         };
 
-        m_tileManager->updateTileSets(viewState, m_view->getVisibleTiles());
+        m_tileManager->updateTileSets(viewState, m_view->getVisibleTiles(), prefetchTiles);
 
         auto& tiles = m_tileManager->getVisibleTiles();
 
@@ -380,7 +418,7 @@ void render() {
 
     m_labels->drawDebug(*m_view);
 
-    FrameInfo::draw(*m_view, *m_tileManager);
+    FrameInfo::draw(*m_view, *m_scene, *m_tileManager, *m_tileWorker);
 }
 
 int getViewportHeight() {
@@ -421,6 +459,7 @@ void setPosition(double _lon, double _lat, float _duration, EaseType _e) {
     getPosition(lon_start, lat_start);
     auto cb = [=](float t) { setPositionNow(ease(lon_start, _lon, t, _e), ease(lat_start, _lat, t, _e)); };
     setEase(EaseField::position, { _duration, cb });
+    m_easeTargetPosition = m_view->getMapProjection().LonLatToMeters({ _lon, _lat });
 
 }
 
@@ -453,6 +492,7 @@ void setZoom(float _z, float _duration, EaseType _e) {
     float z_start = getZoom();
     auto cb = [=](float t) { setZoomNow(ease(z_start, _z, t, _e)); };
     setEase(EaseField::zoom, { _duration, cb });
+    m_easeTargetZoom = _z;
 
 }
 
@@ -599,6 +639,42 @@ void clearDataSource(DataSource& _source, bool _data, bool _tiles) {
     requestRender();
 }
 
+void setDiskCache(const char* _path, size_t _maxSize) {
+    // Data sources and tile data may still reference the old cache, close
+    // its file explicitly before it gets opened again
+    if (m_diskCache) {
+        m_diskCache->detach();
+        m_diskCache.reset();
+    }
+
+    if (_maxSize > 0) {
+        auto diskCache = std::make_shared<DiskCache>(_path, _maxSize);
+        if (diskCache->isOpen()) {
+            m_diskCache = diskCache;
+        }
+    }
+
+    if (m_scene) {
+        for (auto& source : m_scene->dataSources()) {
+            source->setDiskCache(m_diskCache);
+        }
+    }
+}
+
+void setTileBuildPartitions(int _partitions) {
+    if (m_tileWorker) {
+        m_tileWorker->setBuildPartitions(_partitions);
+    }
+}
+
+void getTileMemoryUsage(MemoryUsage& _visible, MemoryUsage& _cached) {
+    if (!m_tileManager) { return; }
+    std::lock_guard<std::mutex> lock(m_tilesMutex);
+
+    _visible = m_tileManager->getVisibleMemoryUsage();
+    _cached = m_tileManager->getTileCache()->getMemoryBreakdown();
+}
+
 void handleTapGesture(float _posX, float _posY) {
 
     m_inputHandler->handleTapGesture(_posX, _posY);
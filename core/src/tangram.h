@@ -2,6 +2,7 @@
 
 #include "data/properties.h"
 #include "util/ease.h"
+#include "util/memoryUsage.h"
 #include <memory>
 #include <vector>
 #include <string>
@@ -115,6 +116,21 @@ bool removeDataSource(DataSource& _source);
 
 void clearDataSource(DataSource& _source, bool _data, bool _tiles);
 
+// Keep downloaded tile data in a file at the given path, using at most _maxSize
+// bytes, so that it is available in later sessions; applies to the data sources
+// of the current scene and of scenes loaded later, a _maxSize of 0 disables the
+// disk cache
+void setDiskCache(const char* _path, size_t _maxSize);
+
+// Split the build of large tiles into up to _partitions parts that run on idle
+// tile workers, lowering the latency of single tiles; applies to scenes loaded
+// after this call, a value of 1 (the default) builds each tile on one worker
+void setTileBuildPartitions(int _partitions);
+
+// Get the memory held by the visible tiles and by the tiles in the tile cache,
+// by category; as of the last call to update()
+void getTileMemoryUsage(MemoryUsage& _visible, MemoryUsage& _cached);
+
 // Respond to a tap at the given screen coordinates (x right, y down)
 void handleTapGesture(float _posX, float _posY);
 
@@ -247,7 +247,7 @@ void FontContext::ScratchBuffer::drawGlyph(const alfons::Rect& q, const alfons::
 
     auto& g = *atlasGlyph.glyph;
     quads->push_back({
-            atlasGlyph.atlas,
+            uint16_t(atlasGlyph.atlas),
             {{glm::vec2{q.x1, q.y1} * TextVertex::position_scale, {g.u1, g.v1}},
              {glm::vec2{q.x1, q.y2} * TextVertex::position_scale, {g.u1, g.v2}},
              {glm::vec2{q.x2, q.y1} * TextVertex::position_scale, {g.u2, g.v1}},
@@ -84,16 +84,21 @@ const std::unique_ptr<StyledMesh>& Tile::getMesh(const Style& _style) const {
     return m_geometry[_style.getID()];
 }
 
-size_t Tile::getMemoryUsage() const {
-    if (m_memoryUsage == 0) {
-        for (auto& entry : m_geometry) {
-            if (entry) {
-                m_memoryUsage += entry->bufferSize();
-            }
+MemoryUsage Tile::getMemoryBreakdown() const {
+    MemoryUsage usage;
+
+    for (auto& entry : m_geometry) {
+        if (entry) {
+            entry->addMemoryUsage(usage);
+        }
+    }
+    for (auto& raster : m_rasters) {
+        if (raster.texture) {
+            raster.texture->addMemoryUsage(usage);
         }
     }
 
-    return m_memoryUsage;
+    return usage;
 }
 
 }
@@ -4,6 +4,7 @@
 #include "glm/vec2.hpp"
 #include "gl/texture.h"
 #include "tileID.h"
+#include "util/memoryUsage.h"
 
 #include <map>
 #include <memory>
@@ -77,8 +78,13 @@ public:
 
     void resetState();
 
-    /* Get the sum in bytes of static <Mesh>es */
-    size_t getMemoryUsage() const;
+    /* Get the memory held by the meshes, labels and raster textures of this
+     * tile, by category. Raster textures shared with other tiles are counted
+     * for each of them. */
+    MemoryUsage getMemoryBreakdown() const;
+
+    /* Get the sum in bytes of <getMemoryBreakdown()> */
+    size_t getMemoryUsage() const { return getMemoryBreakdown().total(); }
 
     int64_t sourceGeneration() const { return m_sourceGeneration; }
 
@@ -116,8 +122,6 @@ private:
     // Map of <Style>s and their associated <Mesh>es
     std::vector<std::unique_ptr<StyledMesh>> m_geometry;
     std::vector<Raster> m_rasters;
-
-    mutable size_t m_memoryUsage = 0;
 };
 
 }
@@ -9,8 +9,18 @@
 #include "util/mapProjection.h"
 #include "view/view.h"
 
+// Minimal number of features for each range of a parallel build
+#define MIN_PARTITION_FEATURES 256
+
 namespace Tangram {
 
+static bool layerContainsCollection(const DataLayer& _datalayer, const Layer& _collection) {
+    if (_collection.name.empty()) { return true; }
+
+    const auto& dlc = _datalayer.collections();
+    return std::find(dlc.begin(), dlc.end(), _collection.name) != dlc.end();
+}
+
 TileBuilder::TileBuilder(std::shared_ptr<Scene> _scene)
     : m_scene(_scene) {
 
@@ -31,18 +41,46 @@ StyleBuilder* TileBuilder::getStyleBuilder(const std::string& _name) {
     return it->second.get();
 }
 
-std::shared_ptr<Tile> TileBuilder::build(TileID _tileID, const TileData& _tileData, const DataSource& _source) {
+void TileBuilder::setParallel(int _partitions, JobRunner _runner) {
+    m_numPartitions = std::max(_partitions, 1);
+    m_jobRunner = _runner;
+}
 
-    auto tile = std::make_shared<Tile>(_tileID, *m_scene->mapProjection(), &_source);
+void TileBuilder::setup(const Tile& _tile, const DataSource& _source, const TileTask* _task) {
+    m_task = _task;
 
-    tile->initGeometry(m_scene->styles().size());
+    m_styleContext.setKeywordZoom(_tile.getID().s);
 
-    m_styleContext.setKeywordZoom(_tileID.s);
+    // Matches depend on the zoom of the tile
+    m_ruleSet.clearCache();
 
     for (auto& builder : m_styleBuilder) {
-        if (builder.second)
-            builder.second->setup(*tile);
+        if (builder.second) {
+            builder.second->setup(_tile);
+            builder.second->setTessellationCache(_source.tessellationCache());
+        }
+    }
+}
+
+size_t TileBuilder::countFeatures(const TileData& _tileData, const DataSource& _source) const {
+    size_t count = 0;
+
+    for (const auto& datalayer : m_scene->layers()) {
+
+        if (datalayer.source() != _source.name()) { continue; }
+
+        for (const auto& collection : _tileData.layers) {
+            if (layerContainsCollection(datalayer, collection)) {
+                count += collection.features.size();
+            }
+        }
     }
+    return count;
+}
+
+void TileBuilder::addFeatures(const TileData& _tileData, const DataSource& _source,
+                              size_t _begin, size_t _end) {
+    size_t pos = 0;
 
     for (const auto& datalayer : m_scene->layers()) {
 
@@ -50,19 +88,95 @@ std::shared_ptr<Tile> TileBuilder::build(TileID _tileID, const TileData& _tileDa
 
         for (const auto& collection : _tileData.layers) {
 
-            if (!collection.name.empty()) {
-                const auto& dlc = datalayer.collections();
-                bool layerContainsCollection =
-                    std::find(dlc.begin(), dlc.end(), collection.name) != dlc.end();
+            if (!layerContainsCollection(datalayer, collection)) { continue; }
 
-                if (!layerContainsCollection) { continue; }
-            }
+            const auto& features = collection.features;
+            size_t first = pos;
+            pos += features.size();
+
+            if (pos <= _begin) { continue; }
+            if (first >= _end) { return; }
 
-            for (const auto& feat : collection.features) {
-                m_ruleSet.apply(feat, datalayer, m_styleContext, *this);
+            size_t from = _begin > first ? _begin - first : 0;
+            size_t to = std::min(_end - first, features.size());
+
+            for (size_t i = from; i < to; i++) {
+                if (isCanceled()) { return; }
+                m_ruleSet.apply(features[i], datalayer, m_styleContext, *this);
             }
         }
     }
+}
+
+void TileBuilder::merge(TileBuilder& _other) {
+    for (auto& builder : m_styleBuilder) {
+        auto it = _other.m_styleBuilder.find(builder.first);
+        if (it == _other.m_styleBuilder.end()) { continue; }
+
+        builder.second->merge(*it->second);
+    }
+    _other.m_task = nullptr;
+}
+
+std::shared_ptr<Tile> TileBuilder::build(TileID _tileID, const TileData& _tileData,
+                                         const DataSource& _source, const TileTask* _task) {
+
+    m_task = _task;
+    if (isCanceled()) {
+        m_task = nullptr;
+        return nullptr;
+    }
+
+    auto tile = std::make_shared<Tile>(_tileID, *m_scene->mapProjection(), &_source);
+
+    tile->initGeometry(m_scene->styles().size());
+
+    setup(*tile, _source, _task);
+
+    size_t numFeatures = countFeatures(_tileData, _source);
+
+    size_t numPartitions = 1;
+    if (m_numPartitions > 1 && m_jobRunner) {
+        numPartitions = std::min(size_t(m_numPartitions), numFeatures / MIN_PARTITION_FEATURES);
+    }
+
+    if (numPartitions > 1) {
+        while (m_partitions.size() < numPartitions - 1) {
+            m_partitions.push_back(std::make_unique<TileBuilder>(m_scene));
+        }
+
+        std::vector<std::function<void()>> jobs;
+
+        for (size_t i = 0; i < numPartitions; i++) {
+            TileBuilder* builder = (i == 0) ? this : m_partitions[i - 1].get();
+            if (i > 0) { builder->setup(*tile, _source, _task); }
+
+            size_t begin = numFeatures * i / numPartitions;
+            size_t end = numFeatures * (i + 1) / numPartitions;
+
+            jobs.push_back([&_tileData, &_source, builder, begin, end]() {
+                builder->addFeatures(_tileData, _source, begin, end);
+            });
+        }
+
+        m_jobRunner(jobs);
+
+        // Merge in feature order, so that the result matches a serial build
+        for (size_t i = 0; i < numPartitions - 1; i++) {
+            merge(*m_partitions[i]);
+        }
+    } else {
+        addFeatures(_tileData, _source, 0, numFeatures);
+    }
+
+    if (isCanceled()) {
+        // Discard the partial meshes to leave the builders clean for the next tile
+        for (auto& builder : m_styleBuilder) {
+            builder.second->build();
+        }
+        m_task = nullptr;
+        return nullptr;
+    }
 
     float tileSize = m_scene->mapProjection()->TileSize() * m_scene->pixelScale();
     float tileScale = pow(2, _tileID.s - _tileID.z);
@@ -80,6 +194,8 @@ std::shared_ptr<Tile> TileBuilder::build(TileID _tileID, const TileData& _tileDa
         tile->setMesh(builder.second->style(), builder.second->build());
     }
 
+    m_task = nullptr;
+
     return tile;
 }
 
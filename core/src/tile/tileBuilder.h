@@ -4,6 +4,10 @@
 #include "scene/styleContext.h"
 #include "scene/drawRule.h"
 #include "labels/labelCollider.h"
+#include "tile/tileTask.h"
+
+#include <functional>
+#include <vector>
 
 namespace Tangram {
 
@@ -17,25 +21,60 @@ class TileBuilder {
 
 public:
 
+    /* Runs all given jobs, possibly in parallel, and returns when they are done */
+    using JobRunner = std::function<void(std::vector<std::function<void()>>&)>;
+
     TileBuilder(std::shared_ptr<Scene> _scene);
 
     ~TileBuilder();
 
     StyleBuilder* getStyleBuilder(const std::string& _name);
 
-    std::shared_ptr<Tile> build(TileID _tileID, const TileData& _data, const DataSource& _source);
+    /* Builds the tile for @_data. Returns nullptr when @_task gets canceled
+     * before the build is finished */
+    std::shared_ptr<Tile> build(TileID _tileID, const TileData& _data, const DataSource& _source,
+                                const TileTask* _task = nullptr);
+
+    /* Checkpoint for the cooperative cancellation of the current build */
+    bool isCanceled() const { return m_task && m_task->isCanceled(); }
 
     const Scene& scene() const { return *m_scene; }
 
+    /* Split the features of large tiles into up to @_partitions ranges.
+     * Each range is built by its own set of StyleBuilders, the ranges run as
+     * jobs of @_runner and are merged in feature order afterwards */
+    void setParallel(int _partitions, JobRunner _runner);
+
 private:
+
+    void setup(const Tile& _tile, const DataSource& _source, const TileTask* _task);
+
+    /* Applies the draw rules to features [_begin, _end) of the features
+     * that belong to data layers of @_source */
+    void addFeatures(const TileData& _data, const DataSource& _source, size_t _begin, size_t _end);
+
+    size_t countFeatures(const TileData& _data, const DataSource& _source) const;
+
+    /* Moves the collected data of @_other behind the data of this builder */
+    void merge(TileBuilder& _other);
+
     std::shared_ptr<Scene> m_scene;
 
+    // Task of the current build
+    const TileTask* m_task = nullptr;
+
     StyleContext m_styleContext;
     DrawRuleMergeSet m_ruleSet;
 
     LabelCollider m_labelLayout;
 
     fastmap<std::string, std::unique_ptr<StyleBuilder>> m_styleBuilder;
+
+    int m_numPartitions = 1;
+    JobRunner m_jobRunner;
+
+    // Builders for all but the first feature range, created on demand
+    std::vector<std::unique_ptr<TileBuilder>> m_partitions;
 };
 
 }
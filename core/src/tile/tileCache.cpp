@@ -0,0 +1,255 @@
+#include "tileCache.h"
+#include "platform.h"
+
+#include <algorithm>
+
+// Initial share of the cache for new tiles, in percent
+#define WINDOW_PERCENT 10
+// Bounds and step of the window share while adapting to the hit ratio
+#define WINDOW_MIN_PERCENT 1
+#define WINDOW_MAX_PERCENT 90
+#define WINDOW_STEP_PERCENT 10
+// Adapt the window after CLIMB_SAMPLE_FACTOR requests per cached tile
+#define CLIMB_SAMPLE_FACTOR 1
+#define CLIMB_MIN_SAMPLES 64
+// Counters per row of the frequency sketch, must be a power of two
+#define SKETCH_WIDTH 1024
+// Halve the counters after SKETCH_SAMPLE_FACTOR samples per cached tile
+#define SKETCH_SAMPLE_FACTOR 10
+// Lower bound of samples between halving the counters
+#define SKETCH_MIN_SAMPLES 256
+
+namespace Tangram {
+
+constexpr int FrequencySketch::DEPTH;
+constexpr uint8_t FrequencySketch::MAX_COUNT;
+constexpr int TileCache::MAX_ZOOM_STATS;
+
+static const uint64_t s_sketchSeeds[] = {
+    0xc3a5c85c97cb3127ull, 0xb492b66fbe98f273ull,
+    0x9ae16a3b2f90404full, 0xcbf29ce484222325ull
+};
+
+FrequencySketch::FrequencySketch(size_t _width)
+    : m_counters(_width * DEPTH, 0),
+      m_mask(_width - 1),
+      m_sampleSize(SKETCH_MIN_SAMPLES) {}
+
+void FrequencySketch::setSampleSize(size_t _samples) {
+    m_sampleSize = std::max<size_t>(_samples, SKETCH_MIN_SAMPLES);
+}
+
+size_t FrequencySketch::index(size_t _hash, int _row) const {
+    uint64_t h = (uint64_t(_hash) + s_sketchSeeds[_row]) * 0x9e3779b97f4a7c15ull;
+    h ^= h >> 32;
+    return _row * (m_mask + 1) + (h & m_mask);
+}
+
+void FrequencySketch::increment(size_t _hash) {
+    for (int row = 0; row < DEPTH; row++) {
+        auto& counter = m_counters[index(_hash, row)];
+        if (counter < MAX_COUNT) { counter++; }
+    }
+
+    if (++m_samples >= m_sampleSize) {
+        // Aging: old accesses count half
+        for (auto& counter : m_counters) { counter >>= 1; }
+        m_samples /= 2;
+    }
+}
+
+uint32_t FrequencySketch::frequency(size_t _hash) const {
+    uint32_t frequency = MAX_COUNT;
+    for (int row = 0; row < DEPTH; row++) {
+        frequency = std::min<uint32_t>(frequency, m_counters[index(_hash, row)]);
+    }
+    return frequency;
+}
+
+void FrequencySketch::clear() {
+    std::fill(m_counters.begin(), m_counters.end(), 0);
+    m_samples = 0;
+}
+
+TileCache::TileCache(size_t _cacheSizeBytes) :
+    m_sketch(SKETCH_WIDTH),
+    m_cacheMaxUsage(_cacheSizeBytes),
+    m_windowPercent(WINDOW_PERCENT),
+    m_windowStep(WINDOW_STEP_PERCENT) {}
+
+std::vector<TileID> TileCache::put(int32_t _sourceId, std::shared_ptr<Tile> _tile) {
+    TileCacheKey k(_sourceId, _tile->getID());
+
+    m_sketch.increment(std::hash<TileCacheKey>()(k));
+
+    auto it = m_cacheMap.find(k);
+    if (it != m_cacheMap.end()) {
+        std::vector<TileID> replaced;
+        evict(it->second, replaced);
+    }
+
+    MemoryUsage usage = _tile->getMemoryBreakdown();
+    size_t size = usage.total();
+
+    m_window.push_front({k, _tile, usage, size, true});
+    m_cacheMap[k] = m_window.begin();
+    m_memoryUsage += usage;
+    m_usage += size;
+    m_windowUsage += size;
+
+    m_sketch.setSampleSize(m_cacheMap.size() * SKETCH_SAMPLE_FACTOR);
+
+    return limitCacheSize(m_cacheMaxUsage);
+}
+
+std::shared_ptr<Tile> TileCache::get(int32_t _sourceId, TileID _tileId) {
+    std::shared_ptr<Tile> tile;
+    TileCacheKey k(_sourceId, _tileId);
+
+    m_sketch.increment(std::hash<TileCacheKey>()(k));
+
+    auto& stats = m_stats[std::min<int>(std::max<int>(_tileId.s, 0), MAX_ZOOM_STATS)];
+    stats.requests++;
+
+    auto it = m_cacheMap.find(k);
+    if (it != m_cacheMap.end()) {
+        auto entry = it->second;
+        tile = std::move(entry->tile);
+
+        m_memoryUsage -= entry->usage;
+        m_usage -= entry->size;
+        if (entry->window) {
+            m_windowUsage -= entry->size;
+            m_window.erase(entry);
+        } else {
+            m_main.erase(entry);
+        }
+        m_cacheMap.erase(it);
+
+        stats.hits++;
+        m_sampleHits++;
+    }
+
+    if (++m_sampleRequests >= std::max<size_t>(m_cacheMap.size() * CLIMB_SAMPLE_FACTOR,
+                                               CLIMB_MIN_SAMPLES)) {
+        adaptWindow();
+    }
+    return tile;
+}
+
+void TileCache::adaptWindow() {
+    // Hill climbing: keep moving the window share in the direction that
+    // improved the hit ratio of the last sample, turn around otherwise
+    double hitRatio = double(m_sampleHits) / m_sampleRequests;
+    if (hitRatio < m_sampleHitRatio) { m_windowStep = -m_windowStep; }
+
+    m_windowPercent = std::min(std::max(m_windowPercent + m_windowStep, WINDOW_MIN_PERCENT),
+                               WINDOW_MAX_PERCENT);
+
+    m_sampleHitRatio = hitRatio;
+    m_sampleRequests = 0;
+    m_sampleHits = 0;
+}
+
+std::shared_ptr<Tile> TileCache::contains(int32_t _source, TileID _tileID) const {
+    TileCacheKey k(_source, _tileID);
+
+    auto it = m_cacheMap.find(k);
+    if (it != m_cacheMap.end()) {
+        return it->second->tile;
+    }
+    return nullptr;
+}
+
+void TileCache::evict(CacheList::iterator _entry, std::vector<TileID>& _evicted) {
+    _evicted.push_back(_entry->tile->getID());
+
+    m_memoryUsage -= _entry->usage;
+    m_usage -= _entry->size;
+    m_cacheMap.erase(_entry->key);
+
+    if (_entry->window) {
+        m_windowUsage -= _entry->size;
+        m_window.erase(_entry);
+    } else {
+        m_main.erase(_entry);
+    }
+}
+
+std::vector<TileID> TileCache::limitCacheSize(size_t _cacheSizeBytes) {
+    std::vector<TileID> poppedTileIDs;
+    m_cacheMaxUsage = _cacheSizeBytes;
+
+    size_t windowMaxUsage = m_cacheMaxUsage / 100 * m_windowPercent;
+    size_t mainMaxUsage = m_cacheMaxUsage - windowMaxUsage;
+
+    while (m_windowUsage > windowMaxUsage) {
+        // Least recently used tile of the window becomes a candidate for the main cache
+        auto candidate = std::prev(m_window.end());
+        m_main.splice(m_main.begin(), m_window, candidate);
+        candidate->window = false;
+        m_windowUsage -= candidate->size;
+
+        uint32_t frequency = m_sketch.frequency(std::hash<TileCacheKey>()(candidate->key));
+
+        while (m_usage - m_windowUsage > mainMaxUsage) {
+            auto victim = std::prev(m_main.end());
+
+            // Ties are admitted: a candidate that was requested as often
+            // as the victim is the more recently used one
+            if (victim == candidate ||
+                m_sketch.frequency(std::hash<TileCacheKey>()(victim->key)) > frequency) {
+                // Not admitted
+                evict(candidate, poppedTileIDs);
+                break;
+            }
+            evict(victim, poppedTileIDs);
+        }
+    }
+
+    // When the limit was reduced
+    while (m_usage > m_cacheMaxUsage) {
+        if (!m_main.empty()) {
+            evict(std::prev(m_main.end()), poppedTileIDs);
+        } else if (!m_window.empty()) {
+            evict(std::prev(m_window.end()), poppedTileIDs);
+        } else {
+            LOGE("Invalid cache state!");
+            m_memoryUsage = MemoryUsage();
+            m_usage = 0;
+            m_windowUsage = 0;
+            break;
+        }
+    }
+
+    return poppedTileIDs;
+}
+
+const TileCacheStats& TileCache::getStats(int _zoom) const {
+    return m_stats[std::min<int>(std::max<int>(_zoom, 0), MAX_ZOOM_STATS)];
+}
+
+TileCacheStats TileCache::getTotalStats() const {
+    TileCacheStats total;
+    for (auto& stats : m_stats) {
+        total.requests += stats.requests;
+        total.hits += stats.hits;
+    }
+    return total;
+}
+
+void TileCache::resetStats() {
+    m_stats.fill(TileCacheStats());
+}
+
+void TileCache::clear() {
+    m_cacheMap.clear();
+    m_window.clear();
+    m_main.clear();
+    m_sketch.clear();
+    m_memoryUsage = MemoryUsage();
+    m_usage = 0;
+    m_windowUsage = 0;
+}
+
+}
@@ -4,9 +4,11 @@
 #include "tile/tileHash.h"
 #include "tile/tileID.h"
 
+#include <array>
 #include <unordered_map>
 #include <list>
 #include <memory>
+#include <vector>
 
 namespace Tangram {
 // TileSet serial + TileID
@@ -27,95 +29,133 @@ namespace std {
 
 namespace Tangram {
 
-class TileCache {
-    struct CacheEntry {
-        TileCacheKey key;
-        std::shared_ptr<Tile> tile;
-    };
+struct TileCacheStats {
+    size_t requests = 0;
+    size_t hits = 0;
 
-    using CacheList = std::list<CacheEntry>;
-    using CacheMap = std::unordered_map<TileCacheKey, typename CacheList::iterator>;
+    double hitRatio() const { return requests > 0 ? double(hits) / requests : 0; }
+};
+
+/* Approximate access counts of tiles in a count-min sketch of 4-bit counters
+ *
+ * Counters are halved after every sample size of increments, so that counts
+ * reflect recent use.
+ */
+class FrequencySketch {
 
 public:
 
-    TileCache(size_t _cacheSizeMB) :
-        m_cacheUsage(0),
-        m_cacheMaxUsage(_cacheSizeMB) {}
+    FrequencySketch(size_t _width);
 
-    std::vector<TileID> put(int32_t _sourceId, std::shared_ptr<Tile> _tile) {
-        TileCacheKey k(_sourceId, _tile->getID());
+    /* Sets the number of increments between halving the counters */
+    void setSampleSize(size_t _samples);
 
-        m_cacheList.push_front({k, _tile});
-        m_cacheMap[k] = m_cacheList.begin();
-        m_cacheUsage += _tile->getMemoryUsage();
+    void increment(size_t _hash);
 
-        return limitCacheSize(m_cacheMaxUsage);
-    }
+    uint32_t frequency(size_t _hash) const;
 
-    std::shared_ptr<Tile> get(int32_t _sourceId, TileID _tileId) {
-        std::shared_ptr<Tile> tile;
-        TileCacheKey k(_sourceId, _tileId);
-
-        auto it = m_cacheMap.find(k);
-        if (it != m_cacheMap.end()) {
-            std::swap(tile, (*(it->second)).tile);
-            m_cacheList.erase(it->second);
-            m_cacheMap.erase(it);
-            m_cacheUsage -= tile->getMemoryUsage();
-        }
-        return tile;
-    }
+    void clear();
 
-    std::shared_ptr<Tile> contains(int32_t _source, TileID _tileID) {
-        std::shared_ptr<Tile> tile;
-        TileCacheKey k(_source, _tileID);
+private:
 
-        auto it = m_cacheMap.find(k);
-        if (it != m_cacheMap.end()) {
-            return it->second->tile;
-        }
-        return nullptr;
-    }
-
-    std::vector<TileID> limitCacheSize(size_t _cacheSizeBytes) {
-        std::vector<TileID> poppedTileIDs;
-        m_cacheMaxUsage = _cacheSizeBytes;
-
-        while (m_cacheUsage > m_cacheMaxUsage) {
-            if (m_cacheList.empty()) {
-                LOGE("Invalid cache state!");
-                m_cacheUsage = 0;
-                break;
-            }
-            auto& tile = m_cacheList.back().tile;
-            poppedTileIDs.push_back(tile->getID());
-            m_cacheUsage -= tile->getMemoryUsage();
-            m_cacheMap.erase(m_cacheList.back().key);
-            m_cacheList.pop_back();
-        }
-        return poppedTileIDs;
-    }
+    static constexpr int DEPTH = 4;
+    static constexpr uint8_t MAX_COUNT = 15;
 
-    size_t getMemoryUsage() const {
-        size_t sum = 0;
-        for (auto& entry : m_cacheList) {
-            sum += entry.tile->getMemoryUsage();
-        }
-        return sum;
-    }
+    size_t index(size_t _hash, int _row) const;
+
+    std::vector<uint8_t> m_counters;
+    size_t m_mask;
+    size_t m_samples = 0;
+    size_t m_sampleSize;
+};
+
+/* Cache of recently used <Tile>s that are not visible anymore
+ *
+ * Admission follows W-TinyLFU: new tiles enter a small LRU window. Tiles
+ * that fall out of the window only replace the least recently used tile of
+ * the main LRU when they were requested at least as often, according to a
+ * <FrequencySketch> of all tile requests. Frequently revisited tiles, e.g.
+ * of low zoom levels, thereby survive one-off scans through many tiles.
+ * The share of the window adapts to the hit ratio, so that recency-heavy
+ * access patterns get a larger window.
+ *
+ * A tile leaves the cache when it is requested with get().
+ */
+class TileCache {
+
+public:
+
+    static constexpr int MAX_ZOOM_STATS = 24;
+
+    TileCache(size_t _cacheSizeBytes);
 
-    void clear() {
-        m_cacheMap.clear();
-        m_cacheList.clear();
-        m_cacheUsage = 0;
-    }
+    /* Adds @_tile, returns the TileIDs of evicted tiles, which may include @_tile */
+    std::vector<TileID> put(int32_t _sourceId, std::shared_ptr<Tile> _tile);
+
+    /* Removes and returns the tile from the cache, counts the request for
+     * the admission policy and hit statistics */
+    std::shared_ptr<Tile> get(int32_t _sourceId, TileID _tileId);
+
+    /* Returns the cached tile without removing it, counting the request or
+     * updating its recency. Use this to probe for proxy tiles */
+    std::shared_ptr<Tile> contains(int32_t _source, TileID _tileID) const;
+
+    std::vector<TileID> limitCacheSize(size_t _cacheSizeBytes);
+
+    /* Sum in bytes of the memory held by cached tiles, as of when they were added */
+    size_t getMemoryUsage() const { return m_usage; }
+
+    /* Memory held by cached tiles by category */
+    const MemoryUsage& getMemoryBreakdown() const { return m_memoryUsage; }
+
+    /* Requests and hits of get() for tiles of zoom level @_zoom */
+    const TileCacheStats& getStats(int _zoom) const;
+
+    TileCacheStats getTotalStats() const;
+
+    void resetStats();
+
+    void clear();
 
 private:
+
+    struct CacheEntry {
+        TileCacheKey key;
+        std::shared_ptr<Tile> tile;
+        MemoryUsage usage;
+        size_t size;
+        bool window;
+    };
+
+    using CacheList = std::list<CacheEntry>;
+    using CacheMap = std::unordered_map<TileCacheKey, typename CacheList::iterator>;
+
+    void evict(CacheList::iterator _entry, std::vector<TileID>& _evicted);
+
+    void adaptWindow();
+
     CacheMap m_cacheMap;
-    CacheList m_cacheList;
 
-    int m_cacheUsage;
-    int m_cacheMaxUsage;
+    // New tiles, and tiles admitted to the main cache, in LRU order
+    CacheList m_window;
+    CacheList m_main;
+
+    FrequencySketch m_sketch;
+
+    MemoryUsage m_memoryUsage;
+    size_t m_usage = 0;
+    size_t m_windowUsage = 0;
+    size_t m_cacheMaxUsage;
+
+    // Share of the window in percent of the cache size, adapted to the
+    // hit ratio of samples of get() requests
+    int m_windowPercent;
+    int m_windowStep;
+    double m_sampleHitRatio = 0;
+    size_t m_sampleRequests = 0;
+    size_t m_sampleHits = 0;
+
+    std::array<TileCacheStats, MAX_ZOOM_STATS + 1> m_stats;
 };
 
 }
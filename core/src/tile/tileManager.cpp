@@ -9,6 +9,7 @@
 #include "glm/gtx/norm.hpp"
 
 #include <algorithm>
+#include <numeric>
 
 #define DBG(...) // LOGD(__VA_ARGS__)
 
@@ -116,14 +117,15 @@ void TileManager::clearTileSet(int32_t _sourceId) {
 }
 
 void TileManager::updateTileSets(const ViewState& _view,
-                                 const std::set<TileID>& _visibleTiles) {
+                                 const std::set<TileID>& _visibleTiles,
+                                 const std::set<TileID>& _prefetchTiles) {
     m_tiles.clear();
-    m_loadPending = 0;
+    m_loadPending.clear();
     m_tilesInProgress = 0;
     m_tileSetChanged = false;
 
     for (auto& tileSet : m_tileSets) {
-        updateTileSet(tileSet, _view, _visibleTiles);
+        updateTileSet(tileSet, _view, _visibleTiles, _prefetchTiles);
     }
 
     loadTiles();
@@ -135,15 +137,23 @@ void TileManager::updateTileSets(const ViewState& _view,
 
     // Remove duplicates: Proxy tiles could have been added more than once
     m_tiles.erase(std::unique(m_tiles.begin(), m_tiles.end()), m_tiles.end());
+
+    m_visibleMemoryUsage = MemoryUsage();
+    for (auto& tile : m_tiles) {
+        m_visibleMemoryUsage += tile->getMemoryBreakdown();
+    }
 }
 
 void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
-                                const std::set<TileID>& _visibleTiles) {
+                                const std::set<TileID>& _visibleTiles,
+                                const std::set<TileID>& _prefetchTiles) {
 
     bool newTiles = false;
+    bool newGeneration = false;
 
     if (_tileSet.sourceGeneration != _tileSet.source->generation()) {
         _tileSet.sourceGeneration = _tileSet.source->generation();
+        newGeneration = true;
     }
 
     // Tile load request above this zoom-level will be canceled in order to
@@ -165,7 +175,9 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
             entry.task.reset();
             newTiles = true;
 
-            m_tileSetChanged = true;
+            if (!entry.isPrefetch() || entry.isVisible()) {
+                m_tileSetChanged = true;
+            }
         }
     }
 
@@ -179,6 +191,29 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
         visibleTiles = &mappedTiles;
     }
 
+    // Mark predicted tiles. Tiles that are no longer predicted lose their
+    // mark and are removed below like any other invisible tile, which
+    // cancels their loading.
+    for (auto& it : tiles) {
+        it.second.setPrefetch(false);
+    }
+
+    for (const auto& prefetchId : _prefetchTiles) {
+        auto id = prefetchId.withMaxSourceZoom(_tileSet.source->maxZoom());
+
+        if (visibleTiles->find(id) != visibleTiles->end()) { continue; }
+
+        auto it = tiles.find(id);
+        if (it == tiles.end()) {
+            // Cached tiles are picked up by addTile() when they become visible
+            if (m_tileCache->contains(_tileSet.source->id(), id)) { continue; }
+
+            std::shared_ptr<Tile> none;
+            it = tiles.emplace(id, none).first;
+        }
+        it->second.setPrefetch(true);
+    }
+
     // Loop over visibleTiles and add any needed tiles to tileSet
     auto curTilesIt = tiles.begin();
     auto visTilesIt = visibleTiles->begin();
@@ -199,6 +234,12 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
                    curTilesIt != tiles.end());
 
             auto& entry = curTilesIt->second;
+
+            if (!entry.isVisible() && !entry.isReady() &&
+                entry.getProxyCounter() == 0 && entry.m_proxies == 0) {
+                // Prefetched tile that just became visible
+                updateProxyTiles(_tileSet, visTileId, entry);
+            }
             entry.setVisible(true);
 
             if (entry.isReady()) {
@@ -263,7 +304,7 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
                     // Cancel loading
                     removeTiles.push_back(curTileId);
                 }
-            } else {
+            } else if (!entry.isPrefetch()) {
                 removeTiles.push_back(curTileId);
             }
             entry.setVisible(false);
@@ -277,6 +318,7 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
 
         if ((it != tiles.end()) &&
             (!it->second.isVisible()) &&
+            (!it->second.isPrefetch()) &&
             (it->second.getProxyCounter() <= 0  ||
              it->first.z >= maxZoom)) {
 
@@ -318,40 +360,56 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view,
             auto tileCenter = _view.mapProjection.TileCenter(id);
             double scaleDiv = exp2(id.z - _view.zoom);
             if (scaleDiv < 1) { scaleDiv = 0.1/scaleDiv; } // prefer parent tiles
-            task->setPriority(glm::length2(tileCenter - _view.center) * scaleDiv);
-            task->setProxyState(entry.getProxyCounter() > 0);
+            double priority = glm::length2(tileCenter - _view.center) * scaleDiv;
+            bool proxy = entry.getProxyCounter() > 0;
+            bool prefetch = entry.isPrefetch() && !entry.isVisible() && !proxy;
+
+            // Tasks of older generations became stale
+            if (task->getPriority() != priority || task->isProxy() != proxy ||
+                task->isPrefetch() != prefetch || newGeneration) {
+                task->setPriority(priority);
+                task->setProxyState(proxy);
+                task->setPrefetchState(prefetch);
+                // Restore queue order of tasks waiting for a worker
+                m_workers.reprioritize(*task);
+            }
 
             // Count tiles that are currently being downloaded to
             // limit download requests.
             if (!task->hasData()) {
-                m_loadPending++;
+                m_loadPending[task->source().id()]++;
             }
 
             for (auto& subTask : task->subTasks()) {
-                if (!subTask->hasData()) { m_loadPending++; }
+                if (!subTask->hasData()) { m_loadPending[subTask->source().id()]++; }
             }
         }
 
         if (entry.isReady()) {
             // Mark as proxy
             entry.tile->setProxyState(entry.getProxyCounter() > 0);
+
+        } else if (!bool(entry.task) && entry.isPrefetch() && !entry.isVisible()) {
+            enqueueTask(_tileSet, it.first, _view, true);
         }
     }
 }
 
 void TileManager::enqueueTask(TileSet& _tileSet, const TileID& _tileID,
-                              const ViewState& _view) {
+                              const ViewState& _view, bool _prefetch) {
+
+    auto& loadTasks = _prefetch ? m_prefetchTasks : m_loadTasks;
 
     // Keep the items sorted by distance
     auto tileCenter = _view.mapProjection.TileCenter(_tileID);
     double distance = glm::length2(tileCenter - _view.center);
 
-    auto it = std::upper_bound(m_loadTasks.begin(), m_loadTasks.end(), distance,
+    auto it = std::upper_bound(loadTasks.begin(), loadTasks.end(), distance,
                                [](auto& distance, auto& other){
                                    return distance < std::get<0>(other);
                                });
 
-    m_loadTasks.insert(it, std::make_tuple(distance, &_tileSet, _tileID));
+    loadTasks.insert(it, std::make_tuple(distance, &_tileSet, _tileID));
 }
 
 // create and download raster references store these
@@ -384,11 +442,11 @@ void TileManager::loadSubTasks(std::vector<std::shared_ptr<DataSource>>& _subSou
             subTasks.insert(it, subTask);
             m_dataCallback.func(std::move(subTask));
 
-        } else if (m_loadPending < MAX_DOWNLOADS) {
+        } else if (canDownload(*subSource)) {
             subTasks.insert(it, subTask);
 
             if (subSource->loadTileData(std::move(subTask), m_dataCallback)) {
-                m_loadPending++;
+                m_loadPending[subSource->id()]++;
 
             } else {
                 // dependent raster's loading failed..
@@ -400,8 +458,14 @@ void TileManager::loadSubTasks(std::vector<std::shared_ptr<DataSource>>& _subSou
     }
 }
 
+bool TileManager::canDownload(const DataSource& _source) {
+    return size_t(m_loadPending[_source.id()]) < _source.maxDownloads();
+}
+
 void TileManager::loadTiles() {
 
+    auto now = DownloadBudget::Clock::now();
+
     for (auto& loadTask : m_loadTasks) {
 
         auto tileId = std::get<2>(loadTask);
@@ -409,6 +473,10 @@ void TileManager::loadTiles() {
         auto tileIt = tileSet.tiles.find(tileId);
         auto& entry = tileIt->second;
 
+        if (entry.m_waitStart == DownloadBudget::Clock::time_point{}) {
+            entry.m_waitStart = now;
+        }
+
         if (entry.task && entry.rastersPending() > 0 && !entry.isCanceled()) {
             // just load the rasters and continue,
             // the main tile task has already started loading
@@ -421,13 +489,18 @@ void TileManager::loadTiles() {
         if (task->hasData()) {
             // Note: Set implicit 'loading' state
             entry.task = task;
+            entry.m_waitStart = {};
             loadSubTasks(tileSet.source->rasterSources(), entry.task, tileId);
             m_dataCallback.func(std::move(task));
 
-        } else if (m_loadPending < MAX_DOWNLOADS) {
+        } else if (canDownload(*tileSet.source)) {
             entry.task = task;
+
+            tileSet.source->downloadBudget().addQueueWait(now - entry.m_waitStart);
+            entry.m_waitStart = {};
+
             if (tileSet.source->loadTileData(std::move(task), m_dataCallback)) {
-                m_loadPending++;
+                m_loadPending[tileSet.source->id()]++;
                 loadSubTasks(tileSet.source->rasterSources(), entry.task, tileId);
             } else {
                 // Set canceled state, so that tile will not be tried
@@ -438,8 +511,41 @@ void TileManager::loadTiles() {
         }
     }
 
+    // Load predicted tiles with the download slots that are left, keeping
+    // one free for tiles that become visible in the meantime.
+    for (auto& loadTask : m_prefetchTasks) {
+
+        auto tileId = std::get<2>(loadTask);
+        auto& tileSet = *std::get<1>(loadTask);
+        auto& entry = tileSet.tiles.find(tileId)->second;
+        auto& source = *tileSet.source;
+
+        auto task = source.createTask(tileId);
+        task->setPrefetchState(true);
+
+        if (task->hasData()) {
+            entry.task = task;
+            loadSubTasks(source.rasterSources(), entry.task, tileId);
+            m_dataCallback.func(std::move(task));
+
+        } else if (size_t(m_loadPending[source.id()] + 1) < source.maxDownloads()) {
+            entry.task = task;
+
+            if (source.loadTileData(std::move(task), m_dataCallback)) {
+                m_loadPending[source.id()]++;
+                loadSubTasks(source.rasterSources(), entry.task, tileId);
+            } else {
+                entry.task->cancel();
+            }
+        }
+    }
+
+    m_prefetchTasks.clear();
+
     DBG("loading:%d pending:%d cache: %fMB",
-        m_loadTasks.size(), m_loadPending,
+        m_loadTasks.size(),
+        std::accumulate(m_loadPending.begin(), m_loadPending.end(), 0,
+                        [](int32_t sum, const auto& entry) { return sum + entry.second; }),
         (double(m_tileCache->getMemoryUsage()) / (1024 * 1024)));
 
     m_loadTasks.clear();
@@ -532,10 +638,13 @@ bool TileManager::updateProxyTile(TileSet& _tileSet, TileEntry& _tile,
         }
     }
 
-    // check if the proxy exists in the cache
+    // check if the proxy exists in the cache. Probe without counting a
+    // request, only a tile that gets used counts for the admission policy
     {
-        auto proxyTile = m_tileCache->get(_tileSet.source->id(), _proxyTileId);
-        if (proxyTile && _tile.setProxy(_proxyId)) {
+        if (m_tileCache->contains(_tileSet.source->id(), _proxyTileId) &&
+            _tile.setProxy(_proxyId)) {
+
+            auto proxyTile = m_tileCache->get(_tileSet.source->id(), _proxyTileId);
 
             auto result = tiles.emplace(_proxyTileId, proxyTile);
             auto& entry = result.first->second;
@@ -35,7 +35,6 @@ struct ViewState {
 class TileManager {
 
     const static size_t DEFAULT_CACHE_SIZE = 32*1024*1024; // 32 MB
-    const static int MAX_DOWNLOADS = 4;
 
 public:
 
@@ -46,8 +45,13 @@ public:
     /* Sets the tile DataSources */
     void setDataSources(const std::vector<std::shared_ptr<DataSource>>& _sources);
 
-    /* Updates visible tile set and load missing tiles */
-    void updateTileSets(const ViewState& _view, const std::set<TileID>& _visibleTiles);
+    /* Updates visible tile set and load missing tiles
+     * @_prefetchTiles: tiles that are predicted to become visible soon. These
+     * are loaded with low priority while download slots are free and are
+     * dropped again when they are no longer predicted.
+     */
+    void updateTileSets(const ViewState& _view, const std::set<TileID>& _visibleTiles,
+                        const std::set<TileID>& _prefetchTiles = {});
 
     void clearTileSets();
 
@@ -56,6 +60,9 @@ public:
     /* Returns the set of currently visible tiles */
     const auto& getVisibleTiles() { return m_tiles; }
 
+    /* Returns the memory held by the visible tiles, as of the last update */
+    const MemoryUsage& getVisibleMemoryUsage() const { return m_visibleMemoryUsage; }
+
     bool hasTileSetChanged() { return m_tileSetChanged; }
 
     bool hasLoadingTiles() { return m_tilesInProgress > 0; }
@@ -166,6 +173,9 @@ private:
 
         bool m_visible = false;
 
+        /* Time when this tile started to wait for a download slot */
+        DownloadBudget::Clock::time_point m_waitStart;
+
         /* Method to check whther this tile is in the current set of visible tiles
          * determined by view::updateTiles().
          */
@@ -176,6 +186,12 @@ private:
         void setVisible(bool _visible) {
             m_visible = _visible;
         }
+
+        bool m_prefetch = false;
+
+        /* Whether this tile is predicted to become visible */
+        bool isPrefetch() const { return m_prefetch; }
+        void setPrefetch(bool _prefetch) { m_prefetch = _prefetch; }
     };
 
     struct TileSet {
@@ -188,11 +204,16 @@ private:
         bool clientDataSource;
     };
 
-    void updateTileSet(TileSet& tileSet, const ViewState& _view, const std::set<TileID>& _visibleTiles);
+    void updateTileSet(TileSet& tileSet, const ViewState& _view, const std::set<TileID>& _visibleTiles,
+                       const std::set<TileID>& _prefetchTiles);
 
-    void enqueueTask(TileSet& _tileSet, const TileID& _tileID, const ViewState& _view);
+    void enqueueTask(TileSet& _tileSet, const TileID& _tileID, const ViewState& _view,
+                     bool _prefetch = false);
 
     void loadTiles();
+
+    /* Whether the download budget of @_source allows another request */
+    bool canDownload(const DataSource& _source);
     void loadSubTasks(std::vector<std::shared_ptr<DataSource>>& subSources, std::shared_ptr<TileTask>& tileTask,
                       const TileID& tileID);
 
@@ -221,7 +242,8 @@ private:
      */
     void clearProxyTiles(TileSet& _tileSet, const TileID& _tileID, TileEntry& _tile, std::vector<TileID>& _removes);
 
-    int32_t m_loadPending = 0;
+    /* Requests per DataSource id that are waiting for tile data */
+    fastmap<int32_t, int32_t> m_loadPending;
     int32_t m_tilesInProgress = 0;
 
     std::vector<TileSet> m_tileSets;
@@ -229,6 +251,8 @@ private:
     /* Current tiles ready for rendering */
     std::vector<std::shared_ptr<Tile>> m_tiles;
 
+    MemoryUsage m_visibleMemoryUsage;
+
     std::unique_ptr<TileCache> m_tileCache;
 
     TileTaskQueue& m_workers;
@@ -243,6 +267,9 @@ private:
     /* Temporary list of tiles that need to be loaded */
     std::vector<std::tuple<double, TileSet*, TileID>> m_loadTasks;
 
+    /* Temporary list of predicted tiles, loaded after m_loadTasks */
+    std::vector<std::tuple<double, TileSet*, TileID>> m_prefetchTasks;
+
 
 };
 
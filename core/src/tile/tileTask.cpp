@@ -14,15 +14,26 @@ TileTask::TileTask(TileID& _tileId, std::shared_ptr<DataSource> _source, int _su
     m_sourceGeneration(_source->generation()),
     m_priority(0) {}
 
+bool TileTask::isStale() const {
+    return m_sourceGeneration < m_source->generation();
+}
+
 void TileTask::process(TileBuilder& _tileBuilder) {
 
-    auto tileData = m_source->parse(*this, *_tileBuilder.scene().mapProjection());
+    // Owned by the scene of the builder, only valid while processing
+    m_decodePlan = _tileBuilder.scene().decodePlan(m_source->name());
+
+    auto& projection = *_tileBuilder.scene().mapProjection();
+    auto tileData = m_source->parse(*this, projection);
 
     if (tileData) {
-        m_tile = _tileBuilder.build(m_tileId, *tileData, *m_source);
+        m_source->simplify(*tileData, m_tileId, projection);
+        m_tile = _tileBuilder.build(m_tileId, *tileData, *m_source, this);
     } else {
         cancel();
     }
+
+    m_decodePlan = nullptr;
 }
 
 void TileTask::complete() {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "tile/tileID.h"
+#include "util/rawBuffer.h"
 
 #include <memory>
 #include <vector>
@@ -14,11 +15,14 @@ class TileBuilder;
 class DataSource;
 class Tile;
 class MapProjection;
+class DecodePlan;
 struct TileData;
 
 
 class TileTask {
 
+    friend class TileWorkQueue;
+
 public:
 
     TileTask(TileID& _tileId, std::shared_ptr<DataSource> _source, int _subTask);
@@ -38,10 +42,15 @@ public:
     DataSource& source() { return *m_source; }
     int64_t sourceGeneration() const { return m_sourceGeneration; }
 
+    // True when the source was cleared after this task was created
+    bool isStale() const;
+
     TileID tileId() const { return m_tileId; }
 
-    void cancel() { m_canceled = true; }
-    bool isCanceled() const { return m_canceled; }
+    // May be called from any thread. Workers check the flag while
+    // processing the task and stop early when it is set.
+    void cancel() { m_canceled.store(true, std::memory_order_relaxed); }
+    bool isCanceled() const { return m_canceled.load(std::memory_order_relaxed); }
 
     double getPriority() const {
         return m_priority.load();
@@ -54,6 +63,14 @@ public:
     void setProxyState(bool isProxy) { m_proxyState = isProxy; }
     bool isProxy() const { return m_proxyState; }
 
+    // Prefetch tasks load tiles that are predicted to become visible
+    void setPrefetchState(bool isPrefetch) { m_prefetchState = isPrefetch; }
+    bool isPrefetch() const { return m_prefetchState; }
+
+    /* Parts of the tile data read by the scene of the processing worker,
+     * nullptr when everything should be decoded. Set by process() */
+    const DecodePlan* decodePlan() const { return m_decodePlan; }
+
     auto& subTasks() { return m_subTasks; }
     int subTaskId() const { return m_subTaskId; }
     bool isSubTask() const { return m_subTaskId >= 0; }
@@ -84,10 +101,20 @@ protected:
     // Tile result, set when tile was  sucessfully created
     std::shared_ptr<Tile> m_tile;
 
-    bool m_canceled = false;
+    std::atomic<bool> m_canceled{false};
 
     std::atomic<double> m_priority;
     bool m_proxyState = false;
+    bool m_prefetchState = false;
+
+    const DecodePlan* m_decodePlan = nullptr;
+
+private:
+
+    // Local queue and heap slot in <TileWorkQueue>, -1 when not queued.
+    // The slot is guarded by the lock of that local queue.
+    std::atomic<int> m_queueId{-1};
+    size_t m_queueSlot = 0;
 };
 
 class DownloadTileTask : public TileTask {
@@ -96,14 +123,17 @@ public:
         : TileTask(_tileId, _source, _subTask) {}
 
     virtual bool hasData() const override {
-        return rawTileData && !rawTileData->empty();
+        return rawTileData && !rawTileData.empty();
     }
     // Raw tile data that will be processed by DataSource.
-    std::shared_ptr<std::vector<char>> rawTileData;
+    RawBuffer rawTileData;
 };
 
 struct TileTaskQueue {
     virtual void enqueue(std::shared_ptr<TileTask>&& task) = 0;
+
+    // Called when priority or proxy state of an enqueued task changed
+    virtual void reprioritize(TileTask& task) {}
 };
 
 struct TileTaskCb {
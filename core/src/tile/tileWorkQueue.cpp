@@ -0,0 +1,228 @@
+#include "tileWorkQueue.h"
+
+#include "data/dataSource.h"
+#include "tile/tileTask.h"
+
+namespace Tangram {
+
+TileWorkQueue::TileWorkQueue(size_t _numQueues) :
+    m_next(0),
+    m_pending(0),
+    m_running(true),
+    m_pendingJobs(0) {
+
+    if (_numQueues == 0) { _numQueues = 1; }
+
+    for (size_t i = 0; i < _numQueues; i++) {
+        m_queues.push_back(std::make_unique<LocalQueue>());
+    }
+}
+
+TileWorkQueue::Key TileWorkQueue::keyOf(TileTask& _task) {
+    return { _task.isPrefetch(), _task.isProxy(), _task.isStale(), _task.getPriority() };
+}
+
+bool TileWorkQueue::isPreferred(TileTask& _a, TileTask& _b) {
+    return keyOf(_a) < keyOf(_b);
+}
+
+bool TileWorkQueue::push(std::shared_ptr<TileTask>&& _task) {
+    if (!m_running) { return false; }
+
+    {
+        // Increment under the wait lock, so that a worker checking the
+        // wait predicate cannot miss the notification. Counting before
+        // inserting keeps m_pending from dropping below the queued tasks.
+        std::lock_guard<std::mutex> lock(m_waitMutex);
+        m_pending++;
+    }
+
+    size_t id = m_next++ % m_queues.size();
+    auto& queue = *m_queues[id];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        Key key = keyOf(*_task);
+        _task->m_queueId = id;
+
+        queue.heap.emplace_back();
+        place(queue, queue.heap.size() - 1, { key, std::move(_task) });
+        siftUp(queue, queue.heap.size() - 1);
+    }
+
+    m_condition.notify_one();
+
+    return true;
+}
+
+void TileWorkQueue::pushJob(std::function<void()>&& _job) {
+    {
+        std::lock_guard<std::mutex> lock(m_waitMutex);
+        m_pendingJobs++;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_jobMutex);
+        m_jobs.push_back(std::move(_job));
+    }
+
+    m_condition.notify_one();
+}
+
+bool TileWorkQueue::popJob(std::function<void()>& _job) {
+    if (m_pendingJobs == 0) { return false; }
+
+    std::lock_guard<std::mutex> lock(m_jobMutex);
+    if (m_jobs.empty()) { return false; }
+
+    _job = std::move(m_jobs.front());
+    m_jobs.pop_front();
+    m_pendingJobs--;
+
+    return true;
+}
+
+bool TileWorkQueue::wait() {
+    if ((m_pending > 0 || m_pendingJobs > 0) && m_running) { return true; }
+
+    std::unique_lock<std::mutex> lock(m_waitMutex);
+    m_condition.wait(lock, [this]{ return !m_running || m_pending > 0 || m_pendingJobs > 0; });
+
+    return m_running;
+}
+
+void TileWorkQueue::place(LocalQueue& _queue, size_t _slot, Entry&& _entry) {
+    _entry.task->m_queueSlot = _slot;
+    _queue.heap[_slot] = std::move(_entry);
+}
+
+void TileWorkQueue::siftUp(LocalQueue& _queue, size_t _slot) {
+    auto& heap = _queue.heap;
+    if (_slot == 0) { return; }
+
+    Entry entry = std::move(heap[_slot]);
+
+    while (_slot > 0) {
+        size_t parent = (_slot - 1) / 2;
+        if (!(entry.key < heap[parent].key)) { break; }
+
+        place(_queue, _slot, std::move(heap[parent]));
+        _slot = parent;
+    }
+    place(_queue, _slot, std::move(entry));
+}
+
+void TileWorkQueue::siftDown(LocalQueue& _queue, size_t _slot) {
+    auto& heap = _queue.heap;
+    size_t size = heap.size();
+
+    Entry entry = std::move(heap[_slot]);
+
+    while (true) {
+        size_t child = 2 * _slot + 1;
+        if (child >= size) { break; }
+
+        if (child + 1 < size && heap[child + 1].key < heap[child].key) {
+            child++;
+        }
+        if (!(heap[child].key < entry.key)) { break; }
+
+        place(_queue, _slot, std::move(heap[child]));
+        _slot = child;
+    }
+    place(_queue, _slot, std::move(entry));
+}
+
+std::shared_ptr<TileTask> TileWorkQueue::removeTop(LocalQueue& _queue) {
+    auto& heap = _queue.heap;
+
+    auto task = std::move(heap.front().task);
+    task->m_queueId = -1;
+
+    if (heap.size() > 1) {
+        place(_queue, 0, std::move(heap.back()));
+        heap.pop_back();
+        siftDown(_queue, 0);
+    } else {
+        heap.pop_back();
+    }
+
+    m_pending--;
+
+    return task;
+}
+
+bool TileWorkQueue::popLocal(LocalQueue& _queue, std::shared_ptr<TileTask>& _task) {
+    while (!_queue.heap.empty()) {
+        auto task = removeTop(_queue);
+
+        // Drop canceled tasks when they come up
+        if (task->isCanceled()) { continue; }
+
+        _task = std::move(task);
+        return true;
+    }
+    return false;
+}
+
+bool TileWorkQueue::pop(size_t _queue, std::shared_ptr<TileTask>& _task) {
+    size_t numQueues = m_queues.size();
+    _queue %= numQueues;
+
+    {
+        auto& local = *m_queues[_queue];
+        std::lock_guard<std::mutex> lock(local.mutex);
+        if (popLocal(local, _task)) { return true; }
+    }
+
+    // Steal from the other queues: skip busy ones on the first round,
+    // block on their locks on the second one.
+    for (int round = 0; round < 2; round++) {
+        for (size_t i = 1; i < numQueues; i++) {
+            if (m_pending == 0) { return false; }
+
+            auto& other = *m_queues[(_queue + i) % numQueues];
+
+            std::unique_lock<std::mutex> lock(other.mutex, std::defer_lock);
+            if (round == 0) {
+                if (!lock.try_lock()) { continue; }
+            } else {
+                lock.lock();
+            }
+            if (popLocal(other, _task)) { return true; }
+        }
+    }
+
+    return false;
+}
+
+void TileWorkQueue::reprioritize(TileTask& _task) {
+    int id = _task.m_queueId;
+    if (id < 0) { return; }
+
+    auto& queue = *m_queues[id];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    // Task may have been popped in the meantime
+    if (_task.m_queueId != id) { return; }
+
+    size_t slot = _task.m_queueSlot;
+    Key key = keyOf(_task);
+    Key old = queue.heap[slot].key;
+    queue.heap[slot].key = key;
+
+    if (key < old) {
+        siftUp(queue, slot);
+    } else if (old < key) {
+        siftDown(queue, slot);
+    }
+}
+
+void TileWorkQueue::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_waitMutex);
+        m_running = false;
+    }
+    m_condition.notify_all();
+}
+
+}
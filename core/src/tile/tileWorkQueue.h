@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Tangram {
+
+class TileTask;
+
+/* Work-stealing queue of <TileTask>s
+ *
+ * Each worker owns a local queue that is guarded by its own lock. New tasks
+ * are distributed round-robin over the local queues, so producers and
+ * consumers rarely contend for the same lock. A worker whose local queue runs
+ * empty steals the best task from one of the other queues.
+ *
+ * Local queues are indexed binary heaps: every queued task knows its heap
+ * slot, so a changed priority is restored in O(log n) by reprioritize()
+ * instead of rescanning the queue on each pop.
+ *
+ * Canceled tasks are not swept eagerly: they are dropped when they reach
+ * the top of a heap.
+ *
+ * Besides tasks the queue holds jobs: parts of a tile build that was split
+ * up by one worker, to be run by the others. Jobs are short and a worker is
+ * waiting for them, so they are taken before any task.
+ */
+class TileWorkQueue {
+
+public:
+
+    TileWorkQueue(size_t _numQueues);
+
+    /* Adds a task; returns false when the queue was stopped */
+    bool push(std::shared_ptr<TileTask>&& _task);
+
+    /* Adds a job. Jobs are accepted after stop() too, as a worker may
+     * still wait for them */
+    void pushJob(std::function<void()>&& _job);
+
+    /* Pops the oldest job. Returns false when no job is queued */
+    bool popJob(std::function<void()>& _job);
+
+    /* Blocks until tasks or jobs are pending or the queue is stopped.
+     * Returns false when the queue was stopped */
+    bool wait();
+
+    /* Pops the highest priority task for worker @_queue, stealing from the
+     * other workers' queues when the local one is empty. Returns false when
+     * no task could be found */
+    bool pop(size_t _queue, std::shared_ptr<TileTask>& _task);
+
+    /* Re-reads priority, proxy, prefetch and stale state of @_task and
+     * restores its heap position. Does nothing when the task is not queued */
+    void reprioritize(TileTask& _task);
+
+    /* Wakes all waiting workers, makes wait() return false from now on */
+    void stop();
+
+    bool isRunning() const { return m_running; }
+
+    /* Number of queued tasks, including canceled ones not yet dropped */
+    size_t size() const { return m_pending; }
+
+    size_t numQueues() const { return m_queues.size(); }
+
+    /* Task ordering: visible tiles before prefetched ones, non-proxy tiles
+     * first, then tasks of the current generation of their source before
+     * stale ones, then lower priority value (distance to the view).
+     * Generations are counted per source, so they are never compared
+     * between tasks of different sources */
+    static bool isPreferred(TileTask& _a, TileTask& _b);
+
+private:
+
+    struct Key {
+        bool prefetch;
+        bool proxy;
+        bool stale;
+        double priority;
+
+        bool operator<(const Key& _other) const {
+            if (prefetch != _other.prefetch) { return !prefetch; }
+            if (proxy != _other.proxy) { return !proxy; }
+            if (stale != _other.stale) { return !stale; }
+            return priority < _other.priority;
+        }
+    };
+
+    struct Entry {
+        Key key;
+        std::shared_ptr<TileTask> task;
+    };
+
+    struct LocalQueue {
+        std::mutex mutex;
+        std::vector<Entry> heap;
+    };
+
+    static Key keyOf(TileTask& _task);
+
+    // Heap operations, must be called with _queue.mutex locked
+    void siftUp(LocalQueue& _queue, size_t _slot);
+    void siftDown(LocalQueue& _queue, size_t _slot);
+    void place(LocalQueue& _queue, size_t _slot, Entry&& _entry);
+    std::shared_ptr<TileTask> removeTop(LocalQueue& _queue);
+    bool popLocal(LocalQueue& _queue, std::shared_ptr<TileTask>& _task);
+
+    std::vector<std::unique_ptr<LocalQueue>> m_queues;
+
+    std::atomic<size_t> m_next;
+    std::atomic<size_t> m_pending;
+    std::atomic<bool> m_running;
+
+    std::mutex m_jobMutex;
+    std::deque<std::function<void()>> m_jobs;
+    std::atomic<size_t> m_pendingJobs;
+
+    // Only used to park idle workers
+    std::mutex m_waitMutex;
+    std::condition_variable m_condition;
+};
+
+}
@@ -7,24 +7,25 @@
 #include "tile/tileBuilder.h"
 #include "tangram.h"
 
-#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 
 #define WORKER_NICENESS 10
 
 namespace Tangram {
 
-TileWorker::TileWorker(int _num_worker) {
-    m_running = true;
+TileWorker::TileWorker(int _num_worker) : m_queue(_num_worker) {
 
     for (int i = 0; i < _num_worker; i++) {
         auto worker = std::make_unique<Worker>();
+        worker->index = i;
         worker->thread = std::thread(&TileWorker::run, this, worker.get());
         m_workers.push_back(std::move(worker));
     }
 }
 
 TileWorker::~TileWorker(){
-    if (m_running) {
+    if (m_queue.isRunning()) {
         stop();
     }
 }
@@ -51,68 +52,60 @@ void TileWorker::run(Worker* instance) {
 
     while (true) {
 
-        std::shared_ptr<TileTask> task;
-        {
-            std::unique_lock<std::mutex> lock(m_mutex);
-
-            m_condition.wait(lock, [&, this]{
-                    return !m_running || !m_queue.empty();
-                });
-
-            if (instance->tileBuilder) {
-                disposeBuilder(std::move(builder));
-
-                builder = std::move(instance->tileBuilder);
-                LOG("Passed new TileBuilder to TileWorker");
-            }
+        bool running = m_queue.wait();
 
-            // Check if thread should stop
-            if (!m_running) {
-                disposeBuilder(std::move(builder));
-                break;
-            }
+        if (instance->tileBuilder) {
+            disposeBuilder(std::move(builder));
 
-            if (!builder) {
-                continue;
-            }
+            builder = std::move(instance->tileBuilder);
+            LOG("Passed new TileBuilder to TileWorker");
+        }
 
-            // Remove all canceled tasks
-            auto removes = std::remove_if(m_queue.begin(), m_queue.end(),
-                                          [](const auto& a) { return a->isCanceled(); });
+        // Check if thread should stop
+        if (!running) {
+            disposeBuilder(std::move(builder));
+            break;
+        }
 
-            m_queue.erase(removes, m_queue.end());
+        // Help with the split-up build of another worker first
+        std::function<void()> job;
+        if (m_queue.popJob(job)) {
+            job();
+            continue;
+        }
 
-            if (m_queue.empty()) {
-                continue;
-            }
+        if (!builder) {
+            continue;
+        }
 
-            // Pop highest priority tile from queue
-            auto it = std::min_element(m_queue.begin(), m_queue.end(),
-                [](const auto& a, const auto& b) {
-                    if (a->isProxy() != b->isProxy()) {
-                        return !a->isProxy();
-                    }
-                    if (a->source().id() == b->source().id() &&
-                        a->sourceGeneration() != b->sourceGeneration()) {
-                        return a->sourceGeneration() < b->sourceGeneration();
-                    }
-                    return a->getPriority() < b->getPriority();
-                });
-
-            task = std::move(*it);
-            m_queue.erase(it);
+        // Pop highest priority tile from the local queue or steal one
+        // from another worker. Canceled tasks are dropped on the way.
+        std::shared_ptr<TileTask> task;
+        if (!m_queue.pop(instance->index, task)) {
+            continue;
         }
 
         if (task->isCanceled()) {
             continue;
         }
 
-        // const clock_t begin = clock();
+        auto begin = std::chrono::steady_clock::now();
 
         task->process(*builder);
 
-        // float loadTime = (float(clock() - begin) / CLOCKS_PER_SEC) * 1000;
-        // LOG("loadTime %s - %f", task->tileID.toString().c_str(), loadTime);
+        double time = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - begin).count();
+
+        {
+            std::lock_guard<std::mutex> lock(m_statsMutex);
+            if (task->isReady()) {
+                m_stats.built++;
+                m_stats.buildTime += time;
+            } else if (task->isCanceled()) {
+                m_stats.canceled++;
+                m_stats.canceledTime += time;
+            }
+        }
 
         requestRender();
     }
@@ -121,27 +114,60 @@ void TileWorker::run(Worker* instance) {
 void TileWorker::setScene(std::shared_ptr<Scene>& _scene) {
     for (auto& worker : m_workers) {
         worker->tileBuilder = std::make_unique<TileBuilder>(_scene);
-    }
-}
 
-void TileWorker::enqueue(std::shared_ptr<TileTask>&& task) {
-    {
-        std::unique_lock<std::mutex> lock(m_mutex);
-        if (!m_running) {
-            return;
+        if (m_buildPartitions > 1) {
+            worker->tileBuilder->setParallel(m_buildPartitions, [this](auto& _jobs) {
+                this->runParallel(_jobs);
+            });
         }
-        m_queue.push_back(std::move(task));
     }
-    m_condition.notify_one();
 }
 
-void TileWorker::stop() {
-    {
-        std::unique_lock<std::mutex> lock(m_mutex);
-        m_running = false;
+void TileWorker::runParallel(std::vector<std::function<void()>>& _jobs) {
+    if (_jobs.empty()) { return; }
+
+    struct Join {
+        std::mutex mutex;
+        std::condition_variable condition;
+        size_t remaining;
+    };
+    auto join = std::make_shared<Join>();
+    join->remaining = _jobs.size() - 1;
+
+    for (size_t i = 1; i < _jobs.size(); i++) {
+        auto& job = _jobs[i];
+        m_queue.pushJob([&job, join]() {
+            job();
+            std::lock_guard<std::mutex> lock(join->mutex);
+            if (--join->remaining == 0) { join->condition.notify_all(); }
+        });
     }
 
-    m_condition.notify_all();
+    _jobs[0]();
+
+    // Run the jobs no other worker has taken yet
+    std::function<void()> job;
+    while (m_queue.popJob(job)) { job(); }
+
+    std::unique_lock<std::mutex> lock(join->mutex);
+    join->condition.wait(lock, [&]{ return join->remaining == 0; });
+}
+
+TileBuildStats TileWorker::buildStats() const {
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    return m_stats;
+}
+
+void TileWorker::enqueue(std::shared_ptr<TileTask>&& task) {
+    m_queue.push(std::move(task));
+}
+
+void TileWorker::reprioritize(TileTask& task) {
+    m_queue.reprioritize(task);
+}
+
+void TileWorker::stop() {
+    m_queue.stop();
 
     for (auto& worker : m_workers) {
         worker->thread.join();
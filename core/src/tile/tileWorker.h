@@ -1,19 +1,38 @@
 #pragma once
 
 #include "tile/tileTask.h"
+#include "tile/tileWorkQueue.h"
 
+#include <algorithm>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <vector>
-#include <condition_variable>
 #include <thread>
-#include <mutex>
-#include <atomic>
 
 namespace Tangram {
 
 class Scene;
 class TileBuilder;
 
+/* Worker time spent on tile tasks, in milliseconds */
+struct TileBuildStats {
+    // Tasks that produced a tile
+    size_t built = 0;
+    double buildTime = 0;
+    // Tasks that stopped early because they were canceled
+    size_t canceled = 0;
+    double canceledTime = 0;
+
+    /* Estimate of the worker time saved by stopping canceled tasks early:
+     * the average time of a finished task for each canceled one, less the
+     * time they ran */
+    double savedTime() const {
+        if (built == 0) { return 0; }
+        return std::max(0.0, canceled * (buildTime / built) - canceledTime);
+    }
+};
+
 class TileWorker : public TileTaskQueue {
 
 public:
@@ -24,30 +43,42 @@ public:
 
     virtual void enqueue(std::shared_ptr<TileTask>&& task) override;
 
+    virtual void reprioritize(TileTask& task) override;
+
     void stop();
 
-    bool isRunning() const { return m_running; }
+    bool isRunning() const { return m_queue.isRunning(); }
 
     void setScene(std::shared_ptr<Scene>& _scene);
 
+    TileBuildStats buildStats() const;
+
+    /* Split the build of a tile into up to @_partitions parts, which run on
+     * idle workers. Applies to the TileBuilders of the next setScene() */
+    void setBuildPartitions(int _partitions) { m_buildPartitions = _partitions; }
+
+    /* Runs @_jobs on the calling thread and on idle workers, returns when
+     * all of them are done */
+    void runParallel(std::vector<std::function<void()>>& _jobs);
+
 private:
 
     struct Worker {
+        size_t index;
         std::thread thread;
         std::unique_ptr<TileBuilder> tileBuilder;
     };
 
     void run(Worker* instance);
 
-    bool m_running;
-
     std::vector<std::unique_ptr<Worker>> m_workers;
 
-    std::condition_variable m_condition;
+    TileWorkQueue m_queue;
 
-    std::mutex m_mutex;
-    std::vector<std::shared_ptr<TileTask>> m_queue;
+    int m_buildPartitions = 1;
 
+    mutable std::mutex m_statsMutex;
+    TileBuildStats m_stats;
 };
 
 }
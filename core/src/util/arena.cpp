@@ -0,0 +1,29 @@
+#include "arena.h"
+
+namespace Tangram {
+
+void* Arena::allocateSlow(size_t _size, size_t _align) {
+    size_t size = _size + _align;
+
+    if (size > m_blockSize / 4) {
+        // Large allocations get a block of their own, so that the rest of
+        // the current block is not wasted
+        m_blocks.emplace_back(new char[size]);
+        m_reserved += size;
+        m_allocated += _size;
+
+        char* block = m_blocks.back().get();
+        size_t offset = (_align - reinterpret_cast<uintptr_t>(block) % _align) % _align;
+        return block + offset;
+    }
+
+    m_blocks.emplace_back(new char[m_blockSize]);
+    m_reserved += m_blockSize;
+
+    m_pos = m_blocks.back().get();
+    m_end = m_pos + m_blockSize;
+
+    return allocate(_size, _align);
+}
+
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace Tangram {
+
+/* Bump allocator for data that is freed all at once
+ *
+ * Memory is handed out from large blocks in allocation order and only
+ * released when the Arena is destroyed. Not thread-safe: an Arena belongs
+ * to the one task that fills it.
+ */
+class Arena {
+
+public:
+
+    Arena(size_t _blockSize = 64 * 1024) : m_blockSize(_blockSize) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(size_t _size, size_t _align) {
+        size_t offset = (_align - reinterpret_cast<uintptr_t>(m_pos) % _align) % _align;
+
+        if (m_pos && size_t(m_end - m_pos) >= _size + offset) {
+            void* ptr = m_pos + offset;
+            m_pos += offset + _size;
+            m_allocated += _size;
+            return ptr;
+        }
+        return allocateSlow(_size, _align);
+    }
+
+    /* Bytes handed out and bytes held in blocks */
+    size_t allocated() const { return m_allocated; }
+    size_t reserved() const { return m_reserved; }
+
+    size_t numBlocks() const { return m_blocks.size(); }
+
+private:
+
+    void* allocateSlow(size_t _size, size_t _align);
+
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+
+    char* m_pos = nullptr;
+    char* m_end = nullptr;
+
+    size_t m_blockSize;
+    size_t m_allocated = 0;
+    size_t m_reserved = 0;
+};
+
+/* Standard allocator drawing from an <Arena>, or from the heap when no arena
+ * is set. Memory from the arena is not freed on deallocate(), containers
+ * using it must not outlive the arena. */
+template<typename T>
+struct ArenaAllocator {
+
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ArenaAllocator(Arena* _arena = nullptr) noexcept : arena(_arena) {}
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& _other) noexcept : arena(_other.arena) {}
+
+    T* allocate(size_t _n) {
+        if (arena) {
+            return static_cast<T*>(arena->allocate(_n * sizeof(T), alignof(T)));
+        }
+        return static_cast<T*>(::operator new(_n * sizeof(T)));
+    }
+
+    void deallocate(T* _ptr, size_t _n) noexcept {
+        if (!arena) { ::operator delete(_ptr); }
+    }
+
+    Arena* arena;
+};
+
+template<typename T, typename U>
+bool operator==(const ArenaAllocator<T>& _a, const ArenaAllocator<U>& _b) { return _a.arena == _b.arena; }
+
+template<typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& _a, const ArenaAllocator<U>& _b) { return _a.arena != _b.arena; }
+
+}
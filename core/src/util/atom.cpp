@@ -0,0 +1,58 @@
+#include "atom.h"
+
+#include <mutex>
+#include <unordered_set>
+
+namespace Tangram {
+
+namespace {
+
+struct AtomTable {
+    std::mutex mutex;
+    // Elements of an unordered_set are never moved, which keeps the
+    // pointers held by Atoms valid as the table grows
+    std::unordered_set<std::string> strings;
+    const std::string* emptyString;
+
+    AtomTable() {
+        emptyString = &*strings.emplace().first;
+    }
+};
+
+AtomTable& table() {
+    static AtomTable* s_table = new AtomTable();
+    return *s_table;
+}
+
+}
+
+Atom::Atom() : m_str(table().emptyString) {}
+
+Atom Atom::intern(const std::string& _str) {
+    auto& t = table();
+    std::lock_guard<std::mutex> lock(t.mutex);
+
+    return Atom(&*t.strings.insert(_str).first);
+}
+
+Atom Atom::find(const std::string& _str) {
+    auto& t = table();
+    std::lock_guard<std::mutex> lock(t.mutex);
+
+    auto it = t.strings.find(_str);
+    if (it == t.strings.end()) { return Atom(); }
+
+    return Atom(&*it);
+}
+
+Atom AtomCache::intern(const std::string& _str) {
+    auto it = m_atoms.find(_str);
+    if (it != m_atoms.end()) { return it->second; }
+
+    Atom atom = Atom::intern(_str);
+    m_atoms.emplace(_str, atom);
+
+    return atom;
+}
+
+}
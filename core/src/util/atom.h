@@ -0,0 +1,70 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+namespace Tangram {
+
+/* Interned string
+ *
+ * Equal strings interned through Atom::intern() share one immutable
+ * instance, so Atoms compare by pointer. Interned strings live until the
+ * process exits and may be read from any thread. Used for property keys,
+ * which are few and repeated across every feature of a tile.
+ *
+ * The table is never shrunk: it grows with every distinct key of the
+ * loaded data. Parsers should only intern the keys that a scene can read,
+ * and go through an <AtomCache> to take the table lock once per key.
+ */
+class Atom {
+
+public:
+
+    /* The Atom of the empty string */
+    Atom();
+
+    /* Returns the Atom of @_str, adding it to the global table if needed */
+    static Atom intern(const std::string& _str);
+
+    /* Returns the Atom of @_str when it was interned before, the empty Atom
+     * otherwise. Does not grow the table. */
+    static Atom find(const std::string& _str);
+
+    const std::string& str() const { return *m_str; }
+
+    bool empty() const { return m_str->empty(); }
+
+    bool operator==(const Atom& _other) const { return m_str == _other.m_str; }
+    bool operator!=(const Atom& _other) const { return m_str != _other.m_str; }
+
+    struct Hash {
+        size_t operator()(const Atom& _atom) const {
+            return std::hash<const std::string*>()(_atom.m_str);
+        }
+    };
+
+private:
+
+    explicit Atom(const std::string* _str) : m_str(_str) {}
+
+    const std::string* m_str;
+};
+
+/* Local map of interned strings, e.g. for the features of one layer.
+ * Not thread-safe, repeated strings do not take the lock of the global
+ * table again */
+class AtomCache {
+
+public:
+
+    Atom intern(const std::string& _str);
+
+    void clear() { m_atoms.clear(); }
+
+private:
+
+    std::unordered_map<std::string, Atom> m_atoms;
+};
+
+}
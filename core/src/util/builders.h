@@ -1,14 +1,22 @@
 #pragma once
 
 #include "data/tileData.h"
+#include "util/geom.h"
 
+#include "glm/gtx/rotate_vector.hpp"
+#include "glm/gtx/norm.hpp"
+
+#include <cmath>
 #include <functional>
+#include <limits>
 #include <vector>
 
 #include "earcut.hpp/include/earcut.hpp"
 
 namespace Tangram {
 
+class TessellationCache;
+
 enum class CapTypes {
     butt = 0, // No points added to end of line
     square = 2, // Two points added to make a square extension
@@ -46,6 +54,9 @@ struct PolygonBuilder {
 
     mapbox::detail::Earcut<uint16_t> earcut;
 
+    // Triangulations of polygons seen before, may be nullptr
+    TessellationCache* cache = nullptr;
+
     PolygonBuilder(PolygonVertexFn _addVertex = [](auto&,auto&,auto&){},
                    bool _useTexCoords = true)
         : addVertex(_addVertex), useTexCoords(_useTexCoords){}
@@ -79,6 +90,14 @@ struct PolyLineBuilder {
     bool closedPolygon;
     bool useTexCoords;
 
+    // Normal and length of the segment from each point of the line to the
+    // next one, see Builders::prepareSegments()
+    std::vector<glm::vec2> segmentNormals;
+    std::vector<float> segmentLengths;
+    // When set, buildPolyLine() keeps the segments of the previous line,
+    // for building the same line again with another cap or join
+    bool reuseSegments = false;
+
     PolyLineBuilder(PolyLineVertexFn _addVertex = [](auto&,auto&,auto&){},
                     CapTypes _cap = CapTypes::butt,
                     JoinTypes _join = JoinTypes::bevel,
@@ -116,21 +135,44 @@ public:
      * @_polygon input coordinates describing the polygon
      * @_ctx output vectors, see <PolygonBuilder>
      */
-    static void buildPolygon(const Polygon& _polygon, float _height, PolygonBuilder& _ctx);
+    static void buildPolygon(const Polygon& _polygon, float _height, PolygonBuilder& _ctx) {
+        buildPolygon(_polygon, _height, _ctx, _ctx.addVertex);
+    }
+
+    /* Like buildPolygon() above, emitting vertices to @_addVertex instead of
+     * _ctx.addVertex. @_addVertex has the signature of PolygonVertexFn and is
+     * called directly, so that it can be inlined.
+     */
+    template<class VertexFn>
+    static void buildPolygon(const Polygon& _polygon, float _height, PolygonBuilder& _ctx,
+                             VertexFn&& _addVertex);
 
     /* Build extruded 'walls' from a polygon
      * @_polygon input coordinates describing the polygon
      * @_minHeight the extrusion will extend from this z coordinate to the z of the polygon points
      * @_ctx output vectors, see <PolygonBuilder>
      */
-    static void buildPolygonExtrusion(const Polygon& _polygon, float _minHeight, float _maxHeight, PolygonBuilder& _ctx);
+    static void buildPolygonExtrusion(const Polygon& _polygon, float _minHeight, float _maxHeight, PolygonBuilder& _ctx) {
+        buildPolygonExtrusion(_polygon, _minHeight, _maxHeight, _ctx, _ctx.addVertex);
+    }
+
+    template<class VertexFn>
+    static void buildPolygonExtrusion(const Polygon& _polygon, float _minHeight, float _maxHeight,
+                                      PolygonBuilder& _ctx, VertexFn&& _addVertex);
 
     /* Build a tesselated polygon line of fixed width from line coordinates
      * @_line input coordinates describing the line
      * @_options parameters for polyline construction
      * @_ctx output vectors, see <PolyLineBuilder>
      */
-    static void buildPolyLine(const Line& _line, PolyLineBuilder& _ctx);
+    static void buildPolyLine(const Line& _line, PolyLineBuilder& _ctx) {
+        buildPolyLine(_line, _ctx, _ctx.addVertex);
+    }
+
+    /* Like buildPolyLine() above, emitting vertices to @_addVertex, which has
+     * the signature of PolyLineVertexFn */
+    template<class VertexFn>
+    static void buildPolyLine(const Line& _line, PolyLineBuilder& _ctx, VertexFn&& _addVertex);
 
     /* Build a tesselated quad centered on _screenOrigin
      * @_screenOrigin the sprite origin in screen space
@@ -139,8 +181,450 @@ public:
      * @_uvTR the top right UV coordinate of the quad
      * @_ctx output vectors, see <SpriteBuilder>
      */
-    static void buildQuadAtPoint(const glm::vec2& _screenOrigin, const glm::vec2& _size, const glm::vec2& _uvBL, const glm::vec2& _uvTR, SpriteBuilder& _ctx);
+    static void buildQuadAtPoint(const glm::vec2& _screenOrigin, const glm::vec2& _size, const glm::vec2& _uvBL, const glm::vec2& _uvTR, SpriteBuilder& _ctx) {
+        buildQuadAtPoint(_screenOrigin, _size, _uvBL, _uvTR, _ctx, _ctx.addVertex);
+    }
+
+    template<class VertexFn>
+    static void buildQuadAtPoint(const glm::vec2& _screenOrigin, const glm::vec2& _size, const glm::vec2& _uvBL,
+                                 const glm::vec2& _uvTR, SpriteBuilder& _ctx, VertexFn&& _addVertex);
+
+private:
+
+    /* Runs earcut on @_polygon, or takes its triangles from _ctx.cache,
+     * and marks the points referenced by the triangles in _ctx.used.
+     * Returns the number of used points */
+    static size_t triangulate(const Polygon& _polygon, PolygonBuilder& _ctx);
+
+    // Get 2D perpendicular of two points
+    static glm::vec2 perp2d(const glm::vec3& _v1, const glm::vec3& _v2) {
+        return glm::vec2(_v2.y - _v1.y, _v1.x - _v2.x);
+    }
+
+    /* Computes _ctx.segmentNormals and _ctx.segmentLengths of @_line, four
+     * segments at a time with SSE2 or NEON when available. The results are
+     * rounded like glm::normalize(perp2d()) and glm::distance() compiled
+     * without fused multiply-adds */
+    static void prepareSegments(const Line& _line, PolyLineBuilder& _ctx);
+
+    // Tests if a line segment (from point A to B) is outside the edge of a tile
+    static bool isOutsideTile(const glm::vec3& _a, const glm::vec3& _b);
+
+    // Adds indices for pairs of vertices arranged like a line strip
+    static void indexPairs(int _nPairs, int _nVertices, std::vector<uint16_t>& _indicesOut);
+
+    template<class VertexFn>
+    static void addPolyLineVertex(const glm::vec3& _coord, const glm::vec2& _normal, const glm::vec2& _uv,
+                                  PolyLineBuilder& _ctx, VertexFn& _addVertex) {
+        _ctx.numVertices++;
+        _addVertex(_coord, _normal, _uv);
+    }
+
+    template<class VertexFn>
+    static void addFan(const glm::vec3& _pC,
+                       const glm::vec2& _nA, const glm::vec2& _nB, const glm::vec2& _nC,
+                       const glm::vec2& _uA, const glm::vec2& _uB, const glm::vec2& _uC,
+                       int _numTriangles, PolyLineBuilder& _ctx, VertexFn& _addVertex);
+
+    template<class VertexFn>
+    static void addCap(const glm::vec3& _coord, const glm::vec2& _normal, int _numCorners, bool _isBeginning,
+                       PolyLineBuilder& _ctx, VertexFn& _addVertex);
+
+    template<class VertexFn>
+    static void buildPolyLineSegment(const Line& _line, PolyLineBuilder& _ctx, size_t _startIndex,
+                                     size_t _endIndex, bool _endCap, VertexFn& _addVertex);
 
 };
 
+template<class VertexFn>
+void Builders::buildPolygon(const Polygon& _polygon, float _height, PolygonBuilder& _ctx,
+                            VertexFn&& _addVertex) {
+
+    glm::vec2 min, max;
+    if (_ctx.useTexCoords) {
+        min = glm::vec2(std::numeric_limits<float>::max());
+        max = glm::vec2(std::numeric_limits<float>::min());
+
+        for (auto& p : _polygon[0]) {
+            min.x = std::min(min.x, p.x);
+            min.y = std::min(min.y, p.y);
+            max.x = std::max(max.x, p.x);
+            max.y = std::max(max.y, p.y);
+        }
+    }
+
+    size_t sumVertices = triangulate(_polygon, _ctx);
+
+    uint16_t vertexDataOffset = _ctx.numVertices;
+    _ctx.numVertices += sumVertices;
+
+    size_t sumPoints = _ctx.used.size();
+    size_t ring = 0;
+    size_t offset = 0;
+
+    // Go through all points of the polyon.
+    for (size_t src = 0, dst = 0; src < sumPoints; src++) {
+        // The points of the polygon rings are indexed linearly.
+        // This maps the indices back to the original ring and point.
+        if (src - offset >= _polygon[ring].size()) {
+            offset += _polygon[ring].size();
+            ring += 1;
+        }
+
+        // Add vertex only when the point is used.
+        if (_ctx.used[src] == 0) { continue; }
+
+        // Keep track of skipped points to update indices
+        _ctx.used[src] = dst++;
+
+        auto& p = _polygon[ring][src - offset];
+        glm::vec3 coord(p.x, p.y, _height);
+        static const glm::vec3 normal(0.0, 0.0, 1.0);
+
+        if (_ctx.useTexCoords) {
+            glm::vec2 uv(mapValue(coord.x, min.x, max.x, 0., 1.),
+                         mapValue(coord.y, min.y, max.y, 1., 0.));
+
+            _addVertex(coord, normal, uv);
+        } else {
+            _addVertex(coord, normal, glm::vec2(0));
+        }
+    }
+
+    for (auto i : _ctx.earcut.indices) {
+        _ctx.indices.push_back(vertexDataOffset + _ctx.used[i]);
+    }
+}
+
+template<class VertexFn>
+void Builders::buildPolygonExtrusion(const Polygon& _polygon, float _minHeight, float _maxHeight,
+                                     PolygonBuilder& _ctx, VertexFn&& _addVertex) {
+
+    auto vertexDataOffset = _ctx.numVertices;
+
+    static const glm::vec3 upVector(0.0f, 0.0f, 1.0f);
+    glm::vec3 normalVector;
+
+    for (auto& line : _polygon) {
+
+        size_t lineSize = line.size();
+
+        for (size_t i = 0; i < lineSize - 1; i++) {
+
+            glm::vec3 a(line[i]);
+            glm::vec3 b(line[i+1]);
+
+            normalVector = glm::cross(upVector, b - a);
+            normalVector = glm::normalize(normalVector);
+
+            if (std::isnan(normalVector.x)
+             || std::isnan(normalVector.y)
+             || std::isnan(normalVector.z)) {
+                continue;
+            }
+
+            // 1st vertex top
+            a.z = _maxHeight;
+            _addVertex(a, normalVector, glm::vec2(1.,0.));
+
+            // 2nd vertex top
+            b.z = _maxHeight;
+            _addVertex(b, normalVector, glm::vec2(0.,0.));
+
+            // 1st vertex bottom
+            a.z = _minHeight;
+            _addVertex(a, normalVector, glm::vec2(1.,1.));
+
+            // 2nd vertex bottom
+            b.z = _minHeight;
+            _addVertex(b, normalVector, glm::vec2(0.,1.));
+
+            // Start the index from the previous state of the vertex Data
+            _ctx.indices.push_back(vertexDataOffset);
+            _ctx.indices.push_back(vertexDataOffset + 1);
+            _ctx.indices.push_back(vertexDataOffset + 2);
+
+            _ctx.indices.push_back(vertexDataOffset + 1);
+            _ctx.indices.push_back(vertexDataOffset + 3);
+            _ctx.indices.push_back(vertexDataOffset + 2);
+
+            vertexDataOffset += 4;
+        }
+
+        _ctx.numVertices = vertexDataOffset;
+    }
+}
+
+//  Tessalate a fan geometry between points A       B
+//  using their normals from a center        \ . . /
+//  and interpolating their UVs               \ p /
+//                                             \./
+//                                              C
+template<class VertexFn>
+void Builders::addFan(const glm::vec3& _pC,
+                      const glm::vec2& _nA, const glm::vec2& _nB, const glm::vec2& _nC,
+                      const glm::vec2& _uA, const glm::vec2& _uB, const glm::vec2& _uC,
+                      int _numTriangles, PolyLineBuilder& _ctx, VertexFn& _addVertex) {
+
+    // Find angle difference
+    float cross = _nA.x * _nB.y - _nA.y * _nB.x; // z component of cross(_CA, _CB)
+    float angle = atan2f(cross, glm::dot(_nA, _nB));
+
+    int startIndex = _ctx.numVertices;
+
+    // Add center vertex
+    addPolyLineVertex(_pC, _nC, _uC, _ctx, _addVertex);
+
+    // Add vertex for point A
+    addPolyLineVertex(_pC, _nA, _uA, _ctx, _addVertex);
+
+    // Add radial vertices
+    glm::vec2 radial = _nA;
+    for (int i = 0; i < _numTriangles; i++) {
+        float frac = (i + 1)/(float)_numTriangles;
+        radial = glm::rotate(_nA, angle * frac);
+
+        glm::vec2 uv(0.0);
+        if (_ctx.useTexCoords) {
+            uv = (1.f - frac) * _uA + frac * _uB;
+        }
+
+        addPolyLineVertex(_pC, radial, uv, _ctx, _addVertex);
+
+        // Add indices
+        _ctx.indices.push_back(startIndex); // center vertex
+        _ctx.indices.push_back(startIndex + i + (angle > 0 ? 1 : 2));
+        _ctx.indices.push_back(startIndex + i + (angle > 0 ? 2 : 1));
+    }
+
+}
+
+// Function to add the vertices for line caps
+template<class VertexFn>
+void Builders::addCap(const glm::vec3& _coord, const glm::vec2& _normal, int _numCorners, bool _isBeginning,
+                      PolyLineBuilder& _ctx, VertexFn& _addVertex) {
+
+    float v = _isBeginning ? 0.f : 1.f; // length-wise tex coord
+
+    if (_numCorners < 1) {
+        // "Butt" cap needs no extra vertices
+        return;
+    } else if (_numCorners == 2) {
+        // "Square" cap needs two extra vertices
+        glm::vec2 tangent(-_normal.y, _normal.x);
+        addPolyLineVertex(_coord, _normal + tangent, {0.f, v}, _ctx, _addVertex);
+        addPolyLineVertex(_coord, -_normal + tangent, {0.f, v}, _ctx, _addVertex);
+        if (!_isBeginning) { // At the beginning of a line we can't form triangles with previous vertices
+            indexPairs(1, _ctx.numVertices, _ctx.indices);
+        }
+        return;
+    }
+
+    // "Round" cap type needs a fan of vertices
+    glm::vec2 nA(_normal), nB(-_normal), nC(0.f, 0.f), uA(1.f, v), uB(0.f, v), uC(0.5f, v);
+    if (_isBeginning) {
+        nA *= -1.f; // To flip the direction of the fan, we negate the normal vectors
+        nB *= -1.f;
+        uA.x = 0.f; // To keep tex coords consistent, we must reverse these too
+        uB.x = 1.f;
+    }
+    addFan(_coord, nA, nB, nC, uA, uB, uC, _numCorners, _ctx, _addVertex);
+}
+
+template<class VertexFn>
+void Builders::buildPolyLineSegment(const Line& _line, PolyLineBuilder& _ctx, size_t _startIndex,
+                                    size_t _endIndex, bool _endCap, VertexFn& _addVertex) {
+
+    float distance = 0; // Cumulative distance along the polyline.
+
+    size_t origLineSize = _line.size();
+
+    // endIndex/startIndex could be wrapped values, calculate lineSize accordingly
+    int lineSize = (int)((_endIndex > _startIndex) ?
+                   (_endIndex - _startIndex) :
+                   (origLineSize - _startIndex + _endIndex));
+    if (lineSize < 2) { return; }
+
+    const glm::vec2* segmentNormals = _ctx.segmentNormals.data();
+    const float* segmentLengths = _ctx.segmentLengths.data();
+
+    glm::vec3 coordCurr(_line[_startIndex]);
+    // get the Point using wrapped index in the original line geometry
+    glm::vec3 coordNext(_line[(_startIndex + 1) % origLineSize]);
+    glm::vec2 normPrev, normNext, miterVec;
+
+    int cornersOnCap = (int)_ctx.cap;
+    int trianglesOnJoin = (int)_ctx.join;
+
+    // Process first point in line with an end cap
+    normNext = segmentNormals[_startIndex];
+
+    if (_endCap) {
+        addCap(coordCurr, normNext, cornersOnCap, true, _ctx, _addVertex);
+    }
+    addPolyLineVertex(coordCurr, normNext, {1.0f, 0.0f}, _ctx, _addVertex); // right corner
+    addPolyLineVertex(coordCurr, -normNext, {0.0f, 0.0f}, _ctx, _addVertex); // left corner
+
+
+    // Process intermediate points
+    for (int i = 1; i < lineSize - 1; i++) {
+        // get the Point using wrapped index in the original line geometry
+        int currIndex = (i + _startIndex) % origLineSize;
+        int nextIndex = (i + _startIndex + 1) % origLineSize;
+
+        distance += segmentLengths[(i + _startIndex - 1) % origLineSize];
+
+        coordCurr = coordNext;
+        coordNext = _line[nextIndex];
+
+        if (coordCurr == coordNext) {
+            continue;
+        }
+
+        normPrev = normNext;
+        normNext = segmentNormals[currIndex];
+
+        // Compute "normal" for miter joint
+        miterVec = normPrev + normNext;
+
+        float scale = 1.f;
+
+        // normPrev and normNext are in the opposite direction
+        // in order to prevent NaN values, we use the perp
+        // vector of those two vectors
+        if (miterVec == glm::zero<glm::vec2>()) {
+            miterVec = perp2d(glm::vec3(normNext, 0.f), glm::vec3(normPrev, 0.f));
+        } else {
+            scale = 2.f / glm::dot(miterVec, miterVec);
+        }
+
+        miterVec *= scale;
+
+        if (glm::length2(miterVec) > glm::length2(_ctx.miterLimit)) {
+            trianglesOnJoin = 1;
+            miterVec *= _ctx.miterLimit / glm::length(miterVec);
+        }
+
+        float v = distance;
+
+        if (trianglesOnJoin == 0) {
+            // Join type is a simple miter
+
+            addPolyLineVertex(coordCurr, miterVec, {1.0, v}, _ctx, _addVertex); // right corner
+            addPolyLineVertex(coordCurr, -miterVec, {0.0, v}, _ctx, _addVertex); // left corner
+            indexPairs(1, _ctx.numVertices, _ctx.indices);
+
+        } else {
+
+            // Join type is a fan of triangles
+
+            bool isRightTurn = (normNext.x * normPrev.y - normNext.y * normPrev.x) > 0; // z component of cross(normNext, normPrev)
+
+            if (isRightTurn) {
+
+                addPolyLineVertex(coordCurr, miterVec, {1.0f, v}, _ctx, _addVertex); // right (inner) corner
+                addPolyLineVertex(coordCurr, -normPrev, {0.0f, v}, _ctx, _addVertex); // left (outer) corner
+                indexPairs(1, _ctx.numVertices, _ctx.indices);
+
+                addFan(coordCurr, -normPrev, -normNext, miterVec, {0.f, v}, {0.f, v}, {1.f, v}, trianglesOnJoin, _ctx, _addVertex);
+
+                addPolyLineVertex(coordCurr, miterVec, {1.0f, v}, _ctx, _addVertex); // right (inner) corner
+                addPolyLineVertex(coordCurr, -normNext, {0.0f, v}, _ctx, _addVertex); // left (outer) corner
+
+            } else {
+
+                addPolyLineVertex(coordCurr, normPrev, {1.0f, v}, _ctx, _addVertex); // right (outer) corner
+                addPolyLineVertex(coordCurr, -miterVec, {0.0f, v}, _ctx, _addVertex); // left (inner) corner
+                indexPairs(1, _ctx.numVertices, _ctx.indices);
+
+                addFan(coordCurr, normPrev, normNext, -miterVec, {1.f, v}, {1.f, v}, {0.0f, v}, trianglesOnJoin, _ctx, _addVertex);
+
+                addPolyLineVertex(coordCurr, normNext, {1.0f, v}, _ctx, _addVertex); // right (outer) corner
+                addPolyLineVertex(coordCurr, -miterVec, {0.0f, v}, _ctx, _addVertex); // left (inner) corner
+            }
+        }
+    }
+
+    distance += segmentLengths[(lineSize - 2 + _startIndex) % origLineSize];
+
+    // Process last point in line with a cap
+    addPolyLineVertex(coordNext, normNext, {1.f, distance}, _ctx, _addVertex); // right corner
+    addPolyLineVertex(coordNext, -normNext, {0.f, distance}, _ctx, _addVertex); // left corner
+    indexPairs(1, _ctx.numVertices, _ctx.indices);
+    if (_endCap) {
+        addCap(coordNext, normNext, cornersOnCap, false, _ctx, _addVertex);
+    }
+
+}
+
+template<class VertexFn>
+void Builders::buildPolyLine(const Line& _line, PolyLineBuilder& _ctx, VertexFn&& _addVertex) {
+
+    size_t lineSize = _line.size();
+
+    if (!_ctx.reuseSegments) {
+        prepareSegments(_line, _ctx);
+    }
+
+    if (_ctx.keepTileEdges) {
+
+        buildPolyLineSegment(_line, _ctx, 0, lineSize, true, _addVertex);
+
+    } else {
+
+        int cut = 0;
+        int firstCutEnd = 0;
+
+        // Determine cuts
+        for (size_t i = 0; i < lineSize - 1; i++) {
+            const glm::vec3& coordCurr = _line[i];
+            const glm::vec3& coordNext = _line[i+1];
+            if (isOutsideTile(coordCurr, coordNext)) {
+                if (cut == 0) {
+                    firstCutEnd = i + 1;
+                }
+                buildPolyLineSegment(_line, _ctx, cut, i + 1, true, _addVertex);
+                cut = i + 1;
+            }
+        }
+
+        if (_ctx.closedPolygon) {
+            if (cut == 0) {
+                // no tile edge cuts!
+                // loop and close the polygon with no endcaps
+                buildPolyLineSegment(_line, _ctx, 0, lineSize+2, false, _addVertex);
+            } else {
+                // merge first and last cut line-segments together
+                buildPolyLineSegment(_line, _ctx, cut, firstCutEnd, true, _addVertex);
+            }
+        } else {
+            buildPolyLineSegment(_line, _ctx, cut, lineSize, true, _addVertex);
+        }
+
+    }
+
+}
+
+template<class VertexFn>
+void Builders::buildQuadAtPoint(const glm::vec2& _screenPosition, const glm::vec2& _size, const glm::vec2& _uvBL,
+                                const glm::vec2& _uvTR, SpriteBuilder& _ctx, VertexFn&& _addVertex) {
+    float halfWidth = _size.x * .5f;
+    float halfHeight = _size.y * .5f;
+
+    _addVertex(glm::vec2(-halfWidth, -halfHeight), _screenPosition, {_uvBL.x, _uvBL.y});
+    _addVertex(glm::vec2(-halfWidth, halfHeight), _screenPosition, {_uvBL.x, _uvTR.y});
+    _addVertex(glm::vec2(halfWidth, -halfHeight), _screenPosition, {_uvTR.x, _uvBL.y});
+    _addVertex(glm::vec2(halfWidth, halfHeight), _screenPosition, {_uvTR.x, _uvTR.y});
+
+    _ctx.indices.push_back(_ctx.numVerts + 2);
+    _ctx.indices.push_back(_ctx.numVerts + 0);
+    _ctx.indices.push_back(_ctx.numVerts + 1);
+    _ctx.indices.push_back(_ctx.numVerts + 1);
+    _ctx.indices.push_back(_ctx.numVerts + 3);
+    _ctx.indices.push_back(_ctx.numVerts + 2);
+
+    _ctx.numVerts += 4;
+
+}
+
 }
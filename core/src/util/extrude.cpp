@@ -47,7 +47,7 @@ Extrude parseExtrudeString(const std::string& _str) {
 
 float getLowerExtrudeMeters(const Extrude& _extrude, const Properties& _props) {
 
-    const static std::string key_min_height("min_height");
+    const static Atom key_min_height = Atom::intern("min_height");
 
     double lower = 0;
 
@@ -64,7 +64,7 @@ float getLowerExtrudeMeters(const Extrude& _extrude, const Properties& _props) {
 
 float getUpperExtrudeMeters(const Extrude& _extrude, const Properties& _props) {
 
-    const static std::string key_height("height");
+    const static Atom key_height = Atom::intern("height");
 
     double upper = 0;
 
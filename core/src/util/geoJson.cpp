@@ -31,9 +31,10 @@ Point GeoJson::getPoint(const JsonValue& _in, const Transform& _proj) {
     return _proj(glm::dvec2(_in[0].GetDouble(), _in[1].GetDouble()));
 }
 
-Line GeoJson::getLine(const JsonValue& _in, const Transform& _proj) {
+Line GeoJson::getLine(const JsonValue& _in, const Transform& _proj, Arena* _arena) {
 
-    Line line;
+    Line line(_arena);
+    line.reserve(_in.Size());
     for (auto itr = _in.Begin(); itr != _in.End(); ++itr) {
         line.push_back(getPoint(*itr, _proj));
     }
@@ -41,11 +42,12 @@ Line GeoJson::getLine(const JsonValue& _in, const Transform& _proj) {
 
 }
 
-Polygon GeoJson::getPolygon(const JsonValue& _in, const Transform& _proj) {
+Polygon GeoJson::getPolygon(const JsonValue& _in, const Transform& _proj, Arena* _arena) {
 
-    Polygon polygon;
+    Polygon polygon(_arena);
+    polygon.reserve(_in.Size());
     for (auto itr = _in.Begin(); itr != _in.End(); ++itr) {
-        polygon.push_back(getLine(*itr, _proj));
+        polygon.push_back(getLine(*itr, _proj, _arena));
     }
     return polygon;
 
@@ -53,6 +55,13 @@ Polygon GeoJson::getPolygon(const JsonValue& _in, const Transform& _proj) {
 
 Properties GeoJson::getProperties(const JsonValue& _in, int32_t _sourceId) {
 
+    AtomCache keys;
+    return getProperties(_in, _sourceId, keys);
+
+}
+
+Properties GeoJson::getProperties(const JsonValue& _in, int32_t _sourceId, AtomCache& _keys) {
+
     std::vector<PropertyItem> items;
     items.reserve(_in.MemberCount());
 
@@ -61,9 +70,9 @@ Properties GeoJson::getProperties(const JsonValue& _in, int32_t _sourceId) {
         const auto& name = it->name.GetString();
         const auto& value = it->value;
         if (value.IsNumber()) {
-            items.emplace_back(name, value.GetDouble());
+            items.emplace_back(_keys.intern(name), value.GetDouble());
         } else if (it->value.IsString()) {
-            items.emplace_back(name, value.GetString());
+            items.emplace_back(_keys.intern(name), value.GetString());
         }
 
     }
@@ -77,14 +86,15 @@ Properties GeoJson::getProperties(const JsonValue& _in, int32_t _sourceId) {
 
 }
 
-Feature GeoJson::getFeature(const JsonValue& _in, const Transform& _proj, int32_t _sourceId) {
+Feature GeoJson::getFeature(const JsonValue& _in, const Transform& _proj, int32_t _sourceId,
+                            AtomCache& _keys, Arena* _arena) {
 
-    Feature feature;
+    Feature feature(_sourceId, _arena);
 
     // Copy properties into tile data
     auto properties = _in.FindMember("properties");
     if (properties != _in.MemberEnd()) {
-        feature.props = getProperties(properties->value, _sourceId);
+        feature.props = getProperties(properties->value, _sourceId, _keys);
     }
 
     // Copy geometry into tile data
@@ -107,25 +117,25 @@ Feature GeoJson::getFeature(const JsonValue& _in, const Transform& _proj, int32_
     } else if (geometryType.compare("LineString") == 0) {
 
         feature.geometryType = GeometryType::lines;
-        feature.lines.push_back(getLine(coords, _proj));
+        feature.lines.push_back(getLine(coords, _proj, _arena));
 
     } else if (geometryType.compare("MultiLineString") == 0) {
 
         feature.geometryType = GeometryType::lines;
         for (auto lineCoords = coords.Begin(); lineCoords != coords.End(); ++lineCoords) {
-            feature.lines.push_back(getLine(*lineCoords, _proj));
+            feature.lines.push_back(getLine(*lineCoords, _proj, _arena));
         }
 
     } else if (geometryType.compare("Polygon") == 0) {
 
         feature.geometryType = GeometryType::polygons;
-        feature.polygons.push_back(getPolygon(coords, _proj));
+        feature.polygons.push_back(getPolygon(coords, _proj, _arena));
 
     } else if (geometryType.compare("MultiPolygon") == 0) {
 
         feature.geometryType = GeometryType::polygons;
         for (auto polyCoords = coords.Begin(); polyCoords != coords.End(); ++polyCoords) {
-            feature.polygons.push_back(getPolygon(*polyCoords, _proj));
+            feature.polygons.push_back(getPolygon(*polyCoords, _proj, _arena));
         }
 
     }
@@ -134,7 +144,8 @@ Feature GeoJson::getFeature(const JsonValue& _in, const Transform& _proj, int32_
 
 }
 
-Layer GeoJson::getLayer(const JsonValue& _in, const Transform& _proj, int32_t _sourceId) {
+Layer GeoJson::getLayer(const JsonValue& _in, const Transform& _proj, int32_t _sourceId,
+                        Arena* _arena) {
 
     Layer layer("");
 
@@ -145,8 +156,10 @@ Layer GeoJson::getLayer(const JsonValue& _in, const Transform& _proj, int32_t _s
         return layer;
     }
 
+    AtomCache keys;
+
     for (auto featureIt = features->value.Begin(); featureIt != features->value.End(); ++featureIt) {
-        layer.features.push_back(getFeature(*featureIt, _proj, _sourceId));
+        layer.features.push_back(getFeature(*featureIt, _proj, _sourceId, keys, _arena));
     }
 
     return layer;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "data/tileData.h"
+#include "util/atom.h"
 #include "util/json.h"
 
 #include <functional>
@@ -15,15 +16,23 @@ bool isFeatureCollection(const JsonValue& _in);
 
 Point getPoint(const JsonValue& _in, const Transform& _proj);
 
-Line getLine(const JsonValue& _in, const Transform& _proj);
+// Geometry containers are allocated from @_arena, or the heap when nullptr
 
-Polygon getPolygon(const JsonValue& _in, const Transform& _proj);
+Line getLine(const JsonValue& _in, const Transform& _proj, Arena* _arena = nullptr);
+
+Polygon getPolygon(const JsonValue& _in, const Transform& _proj, Arena* _arena = nullptr);
 
 Properties getProperties(const JsonValue& _in, int32_t _sourceId);
 
-Feature getFeature(const JsonValue& _in, const Transform& _proj, int32_t _sourceId);
+// Property keys are interned through @_keys, shared by the features of a layer
+
+Properties getProperties(const JsonValue& _in, int32_t _sourceId, AtomCache& _keys);
+
+Feature getFeature(const JsonValue& _in, const Transform& _proj, int32_t _sourceId,
+                   AtomCache& _keys, Arena* _arena = nullptr);
 
-Layer getLayer(const JsonValue& _in, const Transform& _proj, int32_t _sourceId);
+Layer getLayer(const JsonValue& _in, const Transform& _proj, int32_t _sourceId,
+               Arena* _arena = nullptr);
 
 }
 
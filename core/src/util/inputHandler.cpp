@@ -27,14 +27,29 @@ namespace Tangram {
 
 InputHandler::InputHandler(std::shared_ptr<View> _view) : m_view(_view) {}
 
-void InputHandler::update(float _dt) {
+bool InputHandler::isFlinging() const {
 
     auto velocityPanPixels = m_view->pixelsPerMeter() / m_view->pixelScale() * m_velocityPan;
 
-    bool isFlinging = glm::length(velocityPanPixels) > THRESHOLD_STOP_PAN ||
-                      std::abs(m_velocityZoom) > THRESHOLD_STOP_ZOOM;
+    return glm::length(velocityPanPixels) > THRESHOLD_STOP_PAN ||
+           std::abs(m_velocityZoom) > THRESHOLD_STOP_ZOOM;
+}
+
+bool InputHandler::getFlingTarget(glm::dvec2& _position, float& _zoom) const {
+
+    if (!isFlinging()) { return false; }
+
+    // Velocities decay as v' = -damping * v, which adds up
+    // to a total displacement of v / damping.
+    _position = glm::dvec2(m_view->getPosition()) + glm::dvec2(m_velocityPan / DAMPING_PAN);
+    _zoom = m_view->getZoom() + m_velocityZoom / DAMPING_ZOOM;
+
+    return true;
+}
+
+void InputHandler::update(float _dt) {
 
-    if (isFlinging) {
+    if (isFlinging()) {
 
         m_velocityPan -= _dt * DAMPING_PAN * m_velocityPan;
         m_view->translate(_dt * m_velocityPan.x, _dt * m_velocityPan.y);
@@ -23,12 +23,18 @@ public:
 
     void cancelFling();
 
+    /* Sets @_position and @_zoom to where a running fling comes to rest.
+     * Returns false when the view is not flinging */
+    bool getFlingTarget(glm::dvec2& _position, float& _zoom) const;
+
     void setView(std::shared_ptr<View> _view) { m_view = _view; }
 
 private:
 
     void setVelocity(float _zoom, glm::vec2 _pan);
 
+    bool isFlinging() const;
+
     void onGesture();
 
     std::shared_ptr<View> m_view;
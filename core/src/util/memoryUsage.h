@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Tangram {
+
+/* Memory in bytes held by map data, by category */
+struct MemoryUsage {
+    // Vertex and index buffers uploaded to the GPU
+    size_t gpuBuffers = 0;
+    // Compiled vertex and index data waiting for upload
+    size_t cpuBuffers = 0;
+    // Textures uploaded to the GPU
+    size_t gpuTextures = 0;
+    // Copies of texture data kept to upload again after a GL context loss
+    size_t cpuTextures = 0;
+    // Labels and their glyph and sprite quads
+    size_t labels = 0;
+
+    size_t total() const {
+        return gpuBuffers + cpuBuffers + gpuTextures + cpuTextures + labels;
+    }
+
+    MemoryUsage& operator+=(const MemoryUsage& _other) {
+        gpuBuffers += _other.gpuBuffers;
+        cpuBuffers += _other.cpuBuffers;
+        gpuTextures += _other.gpuTextures;
+        cpuTextures += _other.cpuTextures;
+        labels += _other.labels;
+        return *this;
+    }
+
+    MemoryUsage& operator-=(const MemoryUsage& _other) {
+        gpuBuffers -= _other.gpuBuffers;
+        cpuBuffers -= _other.cpuBuffers;
+        gpuTextures -= _other.gpuTextures;
+        cpuTextures -= _other.cpuTextures;
+        labels -= _other.labels;
+        return *this;
+    }
+};
+
+}
@@ -1,9 +1,11 @@
 #include "pbfParser.h"
 
 #include "data/propertyItem.h"
+#include "scene/decodePlan.h"
 #include "tile/tile.h"
 #include "platform.h"
 #include "util/geom.h"
+#include "util/varint.h"
 
 #include <algorithm>
 #include <iterator>
@@ -22,57 +24,79 @@
 
 namespace Tangram {
 
-PbfParser::Geometry PbfParser::getGeometry(ParserContext& _ctx, protobuf::message _geomIn) {
+void PbfParser::getGeometry(ParserContext& _ctx, protobuf::message _geomIn) {
 
-    Geometry geometry;
+    Geometry& geometry = _ctx.geometry;
+    geometry.coordinates.clear();
+    geometry.sizes.clear();
 
-    pbfGeomCmd cmd = pbfGeomCmd::moveTo;
-    uint32_t cmdRepeat = 0;
+    auto& params = geometry.params;
+    auto& coords = geometry.tileCoordinates;
+    coords.clear();
 
-    double invTileExtent = (1.0/(_ctx.tileExtent-1.0));
+    const char* data = _geomIn.getData();
+    const char* end = _geomIn.getEnd();
 
     int64_t x = 0;
     int64_t y = 0;
 
     size_t numCoordinates = 0;
 
-    while(_geomIn.getData() < _geomIn.getEnd()) {
+    while (data < end) {
 
-        if(cmdRepeat == 0) { // get new command, length and parameters..
-            uint32_t cmdData = static_cast<uint32_t>(_geomIn.varint());
-            cmd = static_cast<pbfGeomCmd>(cmdData & 0x7); //first 3 bits of the cmdData
-            cmdRepeat = cmdData >> 3; //last 5 bits
+        uint32_t cmdData;
+        if (Varint::decode(data, end, &cmdData, 1) != 1) {
+            LOGE("invalid geometry command");
+            break;
         }
-
-        if(cmd == pbfGeomCmd::moveTo || cmd == pbfGeomCmd::lineTo) { // get parameters/points
-            // if cmd is move then move to a new line/set of points and save this line
-            if(cmd == pbfGeomCmd::moveTo) {
-                if (geometry.coordinates.size() > 0) {
-                    geometry.sizes.push_back(numCoordinates);
-                }
-                numCoordinates = 0;
+        pbfGeomCmd cmd = static_cast<pbfGeomCmd>(cmdData & 0x7); //first 3 bits of the cmdData
+        uint32_t cmdRepeat = cmdData >> 3; //last 5 bits
+
+        if (cmd == pbfGeomCmd::moveTo || cmd == pbfGeomCmd::lineTo) {
+            // Decode all parameters of the command at once. Each one takes at
+            // least a byte, so a corrupt repeat count cannot allocate more
+            // than the remaining data
+            size_t numParams = 2 * size_t(cmdRepeat);
+            size_t maxParams = std::min(numParams, size_t(end - data));
+            params.resize(maxParams);
+
+            size_t decoded = Varint::decode(data, end, params.data(), maxParams);
+            if (decoded < numParams) {
+                LOGE("truncated geometry parameters");
+                numParams = decoded & ~size_t(1);
             }
 
-            x += _geomIn.svarint();
-            y += _geomIn.svarint();
+            for (size_t i = 0; i < numParams; i += 2) {
+                // if cmd is move then move to a new line/set of points and save this line
+                if (cmd == pbfGeomCmd::moveTo) {
+                    if (coords.size() > 0) {
+                        geometry.sizes.push_back(numCoordinates);
+                    }
+                    numCoordinates = 0;
+                }
 
-            // bring the points in 0 to 1 space
-            Point p;
-            p.x = invTileExtent * (double)x;
-            p.y = invTileExtent * (double)(_ctx.tileExtent - y);
+                int64_t px = x + Varint::zigzag(params[i]);
+                int64_t py = y + Varint::zigzag(params[i+1]);
 
-            if (numCoordinates == 0 || geometry.coordinates.back() != p) {
-                geometry.coordinates.push_back(p);
-                numCoordinates++;
+                // Skip repeated points, compared in tile space
+                if (numCoordinates == 0 || px != x || py != y) {
+                    coords.push_back(static_cast<int32_t>(px));
+                    coords.push_back(static_cast<int32_t>(py));
+                    numCoordinates++;
+                }
+                x = px;
+                y = py;
             }
-        } else if(cmd == pbfGeomCmd::closePath) {
+        } else if (cmd == pbfGeomCmd::closePath) {
             // end of a polygon, push first point in this line as last and push line to poly
-            geometry.coordinates.push_back(geometry.coordinates[geometry.coordinates.size() - numCoordinates]);
-            geometry.sizes.push_back(numCoordinates + 1);
-            numCoordinates = 0;
+            for (uint32_t i = 0; i < cmdRepeat && numCoordinates > 0; i++) {
+                size_t first = coords.size() - 2 * numCoordinates;
+                coords.push_back(coords[first]);
+                coords.push_back(coords[first + 1]);
+                geometry.sizes.push_back(numCoordinates + 1);
+                numCoordinates = 0;
+            }
         }
-
-        cmdRepeat--;
     }
 
     // Enter the last line
@@ -80,12 +104,22 @@ PbfParser::Geometry PbfParser::getGeometry(ParserContext& _ctx, protobuf::messag
         geometry.sizes.push_back(numCoordinates);
     }
 
-    return geometry;
+    // bring the points in 0 to 1 space
+    double invTileExtent = (1.0/(_ctx.tileExtent-1.0));
+
+    size_t numPoints = coords.size() / 2;
+    geometry.coordinates.resize(numPoints);
+
+    for (size_t i = 0; i < numPoints; i++) {
+        Point& p = geometry.coordinates[i];
+        p.x = invTileExtent * (double)coords[2*i];
+        p.y = invTileExtent * (double)(_ctx.tileExtent - coords[2*i+1]);
+    }
 }
 
 Feature PbfParser::getFeature(ParserContext& _ctx, protobuf::message _featureIn) {
 
-    Feature feature(_ctx.sourceId);
+    Feature feature(_ctx.sourceId, _ctx.arena);
 
     _ctx.featureTags.clear();
     _ctx.featureTags.assign(_ctx.keys.size(), -1);
@@ -130,7 +164,7 @@ Feature PbfParser::getFeature(ParserContext& _ctx, protobuf::message _featureIn)
                 break;
             // Actual geometry data
             case FEATURE_GEOM:
-                _ctx.geometry = getGeometry(_ctx, _featureIn.getMessage());
+                getGeometry(_ctx, _featureIn.getMessage());
                 break;
 
             default:
@@ -140,7 +174,7 @@ Feature PbfParser::getFeature(ParserContext& _ctx, protobuf::message _featureIn)
     }
 
     std::vector<Properties::Item> properties;
-    properties.reserve(_ctx.featureTags.size());
+    properties.reserve(_ctx.orderedKeys.size());
 
     for (int tagKey : _ctx.orderedKeys) {
         int tagValue = _ctx.featureTags[tagKey];
@@ -162,7 +196,7 @@ Feature PbfParser::getFeature(ParserContext& _ctx, protobuf::message _featureIn)
             auto pos = _ctx.geometry.coordinates.begin();
             for (int length : _ctx.geometry.sizes) {
                 if (length == 0) { continue; }
-                Line line;
+                Line line(_ctx.arena);
                 line.reserve(length);
                 line.insert(line.begin(), pos, pos + length);
                 pos += length;
@@ -187,7 +221,7 @@ Feature PbfParser::getFeature(ParserContext& _ctx, protobuf::message _featureIn)
                 if (_ctx.winding == 0) {
                     _ctx.winding = winding;
                 }
-                Line line;
+                Line line(_ctx.arena);
                 line.reserve(length);
                 if (_ctx.winding > 0) {
                     line.insert(line.end(), pos, pos + length);
@@ -198,7 +232,7 @@ Feature PbfParser::getFeature(ParserContext& _ctx, protobuf::message _featureIn)
                 rpos -= length;
                 if (winding == _ctx.winding || feature.polygons.empty()) {
                     // This is an exterior polygon.
-                    feature.polygons.emplace_back();
+                    feature.polygons.emplace_back(_ctx.arena);
                 }
                 feature.polygons.back().push_back(std::move(line));
             }
@@ -217,6 +251,7 @@ Layer PbfParser::getLayer(ParserContext& _ctx, protobuf::message _layerIn) {
 
     Layer layer("");
 
+    _ctx.keyNames.clear();
     _ctx.keys.clear();
     _ctx.values.clear();
     _ctx.featureMsgs.clear();
@@ -243,7 +278,7 @@ Layer PbfParser::getLayer(ParserContext& _ctx, protobuf::message _layerIn) {
                 continue;
             }
             case LAYER_KEY: {
-                _ctx.keys.push_back(_layerIn.string());
+                _ctx.keyNames.push_back(_layerIn.string());
                 break;
             }
             case LAYER_VALUE: {
@@ -294,16 +329,20 @@ Layer PbfParser::getLayer(ParserContext& _ctx, protobuf::message _layerIn) {
     if (_ctx.featureMsgs.empty()) { return layer; }
 
     //// Assign ordering to keys for faster sorting
+    _ctx.keys.assign(_ctx.keyNames.size(), Atom());
     _ctx.orderedKeys.clear();
-    _ctx.orderedKeys.reserve(_ctx.keys.size());
-    // assign key ids
-    for (int i = 0, n = _ctx.keys.size(); i < n; i++) {
+    _ctx.orderedKeys.reserve(_ctx.keyNames.size());
+    // assign key ids, skipping keys the scene does not read before they
+    // get interned
+    for (int i = 0, n = _ctx.keyNames.size(); i < n; i++) {
+        if (_ctx.plan && !_ctx.plan->hasKey(_ctx.keyNames[i])) { continue; }
+        _ctx.keys[i] = Atom::intern(_ctx.keyNames[i]);
         _ctx.orderedKeys.push_back(i);
     }
     // sort by Property key ordering
     std::sort(_ctx.orderedKeys.begin(), _ctx.orderedKeys.end(),
               [&](int a, int b) {
-                  return Properties::keyComparator(_ctx.keys[a], _ctx.keys[b]);
+                  return Properties::keyComparator(_ctx.keys[a].str(), _ctx.keys[b].str());
               });
 
     layer.features.reserve(numFeatures);
@@ -319,4 +358,16 @@ Layer PbfParser::getLayer(ParserContext& _ctx, protobuf::message _layerIn) {
     return layer;
 }
 
+std::string PbfParser::getLayerName(protobuf::message _layerIn) {
+
+    // The name usually comes first, in front of the features
+    while (_layerIn.next()) {
+        if (_layerIn.tag == LAYER_NAME) {
+            return _layerIn.string();
+        }
+        _layerIn.skip();
+    }
+    return "";
+}
+
 }
@@ -2,6 +2,7 @@
 
 #include "data/tileData.h"
 #include "pbf/pbf.hpp"
+#include "util/atom.h"
 #include "util/variant.h"
 
 #include <vector>
@@ -10,37 +11,54 @@
 namespace Tangram {
 
 class Tile;
+class DecodePlan;
 
 namespace PbfParser {
 
     struct Geometry {
         std::vector<Point> coordinates;
         std::vector<int> sizes;
+        // Decoding buffers: command parameters and tile space coordinates
+        std::vector<uint32_t> params;
+        std::vector<int32_t> tileCoordinates;
     };
 
     struct ParserContext {
-        ParserContext(int32_t _sourceId) : sourceId(_sourceId){}
+        ParserContext(int32_t _sourceId, const DecodePlan* _plan = nullptr, Arena* _arena = nullptr)
+            : sourceId(_sourceId), plan(_plan), arena(_arena) {}
 
         int32_t sourceId;
-        std::vector<std::string> keys;
+        // Property keys to decode, all when nullptr
+        const DecodePlan* plan;
+        // Memory for the geometry of the features, the heap when nullptr
+        Arena* arena;
+        // Keys of the layer
+        std::vector<std::string> keyNames;
+        // Interned once per layer, features share them. Empty for the
+        // keys that the scene does not read
+        std::vector<Atom> keys;
         std::vector<Value> values;
         std::vector<protobuf::message> featureMsgs;
         Geometry geometry;
         // Map Key ID -> Tag values
         std::vector<int> featureTags;
-        // Key IDs sorted by Property key ordering
+        // IDs of the decoded keys, sorted by Property key ordering
         std::vector<int> orderedKeys;
 
         int tileExtent = 0;
         int winding = 0;
     };
 
-    Geometry getGeometry(ParserContext& _ctx, protobuf::message _geomIn);
+    /* Decodes @_geomIn into _ctx.geometry, reusing its buffers */
+    void getGeometry(ParserContext& _ctx, protobuf::message _geomIn);
 
     Feature getFeature(ParserContext& _ctx, protobuf::message _featureIn);
 
     Layer getLayer(ParserContext& _ctx, protobuf::message _layerIn);
 
+    /* Reads only the name of the layer message @_layerIn */
+    std::string getLayerName(protobuf::message _layerIn);
+
     enum pbfGeomCmd {
         moveTo = 1,
         lineTo = 2,
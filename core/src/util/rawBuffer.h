@@ -0,0 +1,47 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+namespace Tangram {
+
+/* Immutable, reference counted view of raw tile bytes
+ *
+ * Copies of a RawBuffer share the bytes. The bytes are either a downloaded
+ * vector that was moved in, or memory owned by another object, e.g. a
+ * record of the memory-mapped <DiskCache> that stays valid while the
+ * owner is referenced.
+ */
+class RawBuffer {
+
+public:
+
+    RawBuffer() {}
+
+    explicit RawBuffer(std::vector<char>&& _data) {
+        auto data = std::make_shared<std::vector<char>>(std::move(_data));
+        m_data = data->data();
+        m_size = data->size();
+        m_owner = std::move(data);
+    }
+
+    RawBuffer(std::shared_ptr<const void> _owner, const char* _data, size_t _size)
+        : m_owner(std::move(_owner)), m_data(_data), m_size(_size) {}
+
+    const char* data() const { return m_data; }
+
+    size_t size() const { return m_size; }
+
+    bool empty() const { return m_size == 0; }
+
+    /* False when no data was set, also an empty response sets the buffer */
+    explicit operator bool() const { return bool(m_owner); }
+
+private:
+
+    std::shared_ptr<const void> m_owner;
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+}
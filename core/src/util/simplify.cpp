@@ -0,0 +1,104 @@
+#include "simplify.h"
+
+#include "glm/glm.hpp"
+
+#include <algorithm>
+
+namespace Tangram {
+
+// Squared distance of @_p to the segment from @_a to @_b, in the xy-plane
+static float segmentDistance2(const Point& _p, const Point& _a, const Point& _b) {
+    glm::vec2 ab(_b.x - _a.x, _b.y - _a.y);
+    glm::vec2 ap(_p.x - _a.x, _p.y - _a.y);
+
+    float length2 = glm::dot(ab, ab);
+    float t = 0.f;
+    if (length2 > 0.f) {
+        t = std::min(std::max(glm::dot(ap, ab) / length2, 0.f), 1.f);
+    }
+
+    glm::vec2 d = ap - ab * t;
+    return glm::dot(d, d);
+}
+
+static bool isOutsideTile(const Point& _p) {
+    return _p.x < 0.f || _p.x > 1.f || _p.y < 0.f || _p.y > 1.f;
+}
+
+size_t Simplifier::simplify(Line& _line, size_t _minPoints) {
+
+    size_t size = _line.size();
+    if (size < 3 || size <= _minPoints) { return 0; }
+
+    m_keep.assign(size, 0);
+    m_keep[0] = m_keep[size - 1] = 1;
+
+    for (size_t i = 1; i < size - 1; i++) {
+        if (isOutsideTile(_line[i])) { m_keep[i] = 1; }
+    }
+
+    // Simplify the ranges between the points that are always kept
+    m_stack.clear();
+    for (size_t start = 0, i = 1; i < size; i++) {
+        if (m_keep[i]) {
+            if (i - start > 1) { m_stack.emplace_back(start, i); }
+            start = i;
+        }
+    }
+
+    while (!m_stack.empty()) {
+        size_t start = m_stack.back().first;
+        size_t end = m_stack.back().second;
+        m_stack.pop_back();
+
+        float maxDistance2 = 0.f;
+        size_t farthest = 0;
+
+        for (size_t i = start + 1; i < end; i++) {
+            float distance2 = segmentDistance2(_line[i], _line[start], _line[end]);
+            if (distance2 > maxDistance2) {
+                maxDistance2 = distance2;
+                farthest = i;
+            }
+        }
+
+        if (maxDistance2 <= m_tolerance2) { continue; }
+
+        m_keep[farthest] = 1;
+        if (farthest - start > 1) { m_stack.emplace_back(start, farthest); }
+        if (end - farthest > 1) { m_stack.emplace_back(farthest, end); }
+    }
+
+    size_t kept = std::count(m_keep.begin(), m_keep.end(), 1);
+    if (kept < _minPoints || kept == size) { return 0; }
+
+    size_t pos = 0;
+    for (size_t i = 0; i < size; i++) {
+        if (m_keep[i]) { _line[pos++] = _line[i]; }
+    }
+    _line.erase(_line.begin() + pos, _line.end());
+
+    return size - kept;
+}
+
+void Simplifier::simplify(TileData& _tileData, SimplifyStats& _stats) {
+
+    for (auto& layer : _tileData.layers) {
+        for (auto& feature : layer.features) {
+
+            for (auto& line : feature.lines) {
+                _stats.points += line.size();
+                _stats.removed += simplify(line);
+            }
+
+            for (auto& polygon : feature.polygons) {
+                for (auto& ring : polygon) {
+                    _stats.points += ring.size();
+                    _stats.removed += simplify(ring, 4);
+                }
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "data/tileData.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Tangram {
+
+struct SimplifyStats {
+    // Points of the simplified lines and polygon rings
+    size_t points = 0;
+    // Points that were removed from them
+    size_t removed = 0;
+};
+
+/* Douglas-Peucker simplification of the lines and polygons of a tile
+ *
+ * Removes the points that lie closer than the tolerance, in tile units, to
+ * the simplified geometry. Points outside of the tile are always kept, so
+ * that the segments along tile edges that are cut by the polyline builder
+ * stay the same. Polygon rings keep at least four points.
+ */
+class Simplifier {
+
+public:
+
+    explicit Simplifier(float _tolerance) : m_tolerance2(_tolerance * _tolerance) {}
+
+    /* Simplifies all lines and polygon rings of @_tileData in place */
+    void simplify(TileData& _tileData, SimplifyStats& _stats);
+
+    /* Simplifies @_line in place unless fewer than @_minPoints would be
+     * left. Returns the number of removed points */
+    size_t simplify(Line& _line, size_t _minPoints = 2);
+
+private:
+
+    float m_tolerance2;
+
+    // Scratch buffers, reused for all lines
+    std::vector<uint8_t> m_keep;
+    std::vector<std::pair<size_t, size_t>> m_stack;
+};
+
+}
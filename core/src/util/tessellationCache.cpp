@@ -0,0 +1,136 @@
+#include "tessellationCache.h"
+
+#include "util/hash.h"
+
+namespace Tangram {
+
+constexpr size_t TessellationCache::NUM_SHARDS;
+
+size_t TessellationCache::CacheEntry::usage() const {
+    return sizeof(CacheEntry) +
+        rings.size() * sizeof(uint32_t) +
+        points.size() * sizeof(glm::vec2) +
+        indices.size() * sizeof(uint16_t);
+}
+
+bool TessellationCache::CacheEntry::matches(const Polygon& _polygon) const {
+    if (rings.size() != _polygon.size()) { return false; }
+
+    size_t offset = 0;
+    for (size_t i = 0; i < rings.size(); i++) {
+        auto& ring = _polygon[i];
+        if (rings[i] != ring.size()) { return false; }
+
+        for (auto& p : ring) {
+            auto& q = points[offset++];
+            if (p.x != q.x || p.y != q.y) { return false; }
+        }
+    }
+    return true;
+}
+
+void TessellationCache::setMaxUsage(size_t _maxUsage) {
+    m_maxUsage = _maxUsage;
+    m_maxShardUsage = _maxUsage / NUM_SHARDS;
+}
+
+size_t TessellationCache::usage() const {
+    size_t usage = 0;
+    for (auto& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        usage += shard.usage;
+    }
+    return usage;
+}
+
+size_t TessellationCache::hash(const Polygon& _polygon) {
+    size_t seed = 0;
+    for (auto& ring : _polygon) {
+        hash_combine(seed, ring.size());
+        for (auto& p : ring) {
+            hash_combine(seed, p.x);
+            hash_combine(seed, p.y);
+        }
+    }
+    return seed;
+}
+
+bool TessellationCache::get(const Polygon& _polygon, size_t _hash, std::vector<uint16_t>& _indices) {
+
+    if (m_maxShardUsage == 0) { return false; }
+
+    auto& shard = this->shard(_hash);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.map.find(_hash);
+    if (it == shard.map.end() || !it->second->matches(_polygon)) {
+        m_misses++;
+        return false;
+    }
+
+    // Move cached entry to start of list
+    shard.list.splice(shard.list.begin(), shard.list, it->second);
+    _indices = shard.list.front().indices;
+
+    m_hits++;
+    return true;
+}
+
+void TessellationCache::put(const Polygon& _polygon, size_t _hash, const std::vector<uint16_t>& _indices) {
+
+    size_t maxUsage = m_maxShardUsage;
+    if (maxUsage == 0) { return; }
+
+    CacheEntry entry { _hash, {}, {}, _indices };
+    entry.rings.reserve(_polygon.size());
+    for (auto& ring : _polygon) {
+        entry.rings.push_back(ring.size());
+        for (auto& p : ring) {
+            entry.points.emplace_back(p.x, p.y);
+        }
+    }
+
+    size_t entryUsage = entry.usage();
+    if (entryUsage > maxUsage) { return; }
+
+    auto& shard = this->shard(_hash);
+
+    // Evicted entries are released after the lock
+    CacheList evicted;
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.map.find(_hash);
+    if (it != shard.map.end()) {
+        shard.usage -= it->second->usage();
+        evicted.splice(evicted.end(), shard.list, it->second);
+    }
+
+    shard.list.push_front(std::move(entry));
+    shard.map[_hash] = shard.list.begin();
+    shard.usage += entryUsage;
+
+    while (shard.usage > maxUsage) {
+        auto& last = shard.list.back();
+        shard.usage -= last.usage();
+
+        shard.map.erase(last.hash);
+        evicted.splice(evicted.end(), shard.list, std::prev(shard.list.end()));
+    }
+}
+
+void TessellationCache::clear() {
+    for (auto& shard : m_shards) {
+        CacheList evicted;
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.map.clear();
+        evicted.swap(shard.list);
+        shard.usage = 0;
+    }
+    m_hits = 0;
+    m_misses = 0;
+}
+
+}
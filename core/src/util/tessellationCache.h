@@ -0,0 +1,88 @@
+#pragma once
+
+#include "data/tileData.h"
+
+#include "glm/vec2.hpp"
+
+#include <array>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Tangram {
+
+/* LRU cache for the triangulation of polygons, see Builders::buildPolygon()
+ *
+ * Each entry keeps the earcut indices of a polygon together with its
+ * rings, so that a lookup only hits for a polygon with exactly the same
+ * coordinates. A polygon that is drawn by several styles, or again when
+ * its tile is rebuilt after a scene update, is then triangulated once.
+ *
+ * Owned by a <DataSource> and cleared with its data. Lookups run on the
+ * worker threads, entries are distributed over NUM_SHARDS independent LRU
+ * lists by their hash like in <RawCache>.
+ */
+class TessellationCache {
+
+public:
+
+    static constexpr size_t NUM_SHARDS = 8;
+
+    /* Limit of cached bytes, 0 disables the cache */
+    void setMaxUsage(size_t _maxUsage);
+
+    size_t maxUsage() const { return m_maxUsage; }
+
+    /* Sum of the shards' usage, the shards are not locked together */
+    size_t usage() const;
+
+    /* Hash of the coordinates that earcut reads from @_polygon */
+    static size_t hash(const Polygon& _polygon);
+
+    /* Copies the cached triangle indices of @_polygon to @_indices */
+    bool get(const Polygon& _polygon, size_t _hash, std::vector<uint16_t>& _indices);
+
+    void put(const Polygon& _polygon, size_t _hash, const std::vector<uint16_t>& _indices);
+
+    void clear();
+
+    /* Lookups that found or missed their polygon since the last clear() */
+    size_t hits() const { return m_hits; }
+    size_t misses() const { return m_misses; }
+
+private:
+
+    struct CacheEntry {
+        size_t hash;
+        std::vector<uint32_t> rings;
+        std::vector<glm::vec2> points;
+        std::vector<uint16_t> indices;
+
+        size_t usage() const;
+        bool matches(const Polygon& _polygon) const;
+    };
+
+    using CacheList = std::list<CacheEntry>;
+    using CacheMap = std::unordered_map<size_t, typename CacheList::iterator>;
+
+    struct Shard {
+        mutable std::mutex mutex;
+        CacheMap map;
+        CacheList list;
+        size_t usage = 0;
+    };
+
+    Shard& shard(size_t _hash) { return m_shards[_hash % NUM_SHARDS]; }
+
+    std::array<Shard, NUM_SHARDS> m_shards;
+
+    std::atomic<size_t> m_maxUsage{0};
+    std::atomic<size_t> m_maxShardUsage{0};
+
+    std::atomic<size_t> m_hits{0};
+    std::atomic<size_t> m_misses{0};
+};
+
+}
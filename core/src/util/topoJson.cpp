@@ -79,9 +79,9 @@ Point getPoint(const JsonValue& _coordinates, const Topology& _topology, glm::iv
 
 }
 
-Line getLine(const JsonValue& _arcs, const Topology& _topology) {
+Line getLine(const JsonValue& _arcs, const Topology& _topology, Arena* _arena) {
 
-    Line line;
+    Line line(_arena);
 
     if (!_arcs.IsArray()) {
         return line;
@@ -128,9 +128,9 @@ Line getLine(const JsonValue& _arcs, const Topology& _topology) {
 
 }
 
-Polygon getPolygon(const JsonValue& _arcSets, const Topology& _topology) {
+Polygon getPolygon(const JsonValue& _arcSets, const Topology& _topology, Arena* _arena) {
 
-    Polygon polygon;
+    Polygon polygon(_arena);
 
     if (!_arcSets.IsArray()) {
         return polygon;
@@ -138,8 +138,7 @@ Polygon getPolygon(const JsonValue& _arcSets, const Topology& _topology) {
 
     for (auto arcSetIt = _arcSets.Begin(); arcSetIt != _arcSets.End(); ++arcSetIt) {
 
-        auto ring = getLine(*arcSetIt, _topology);
-        polygon.push_back(ring);
+        polygon.push_back(getLine(*arcSetIt, _topology, _arena));
 
     }
 
@@ -147,18 +146,19 @@ Polygon getPolygon(const JsonValue& _arcSets, const Topology& _topology) {
 
 }
 
-Feature getFeature(const JsonValue& _geometry, const Topology& _topology, int32_t _source) {
+Feature getFeature(const JsonValue& _geometry, const Topology& _topology, int32_t _source,
+                   AtomCache& _keys, Arena* _arena) {
 
     static const JsonValue keyProperties("properties");
     static const JsonValue keyType("type");
     static const JsonValue keyCoordinates("coordinates");
     static const JsonValue keyArcs("arcs");
 
-    Feature feature;
+    Feature feature(_source, _arena);
 
     auto propertiesIt = _geometry.FindMember(keyProperties);
     if (propertiesIt != _geometry.MemberEnd() && propertiesIt->value.IsObject()) {
-        feature.props = GeoJson::getProperties(propertiesIt->value, _source);
+        feature.props = GeoJson::getProperties(propertiesIt->value, _source, _keys);
     }
 
     std::string type;
@@ -188,7 +188,7 @@ Feature getFeature(const JsonValue& _geometry, const Topology& _topology, int32_
         feature.geometryType = GeometryType::lines;
         auto arcsIt = _geometry.FindMember(keyArcs);
         if (arcsIt != _geometry.MemberEnd()) {
-            feature.lines.push_back(getLine(arcsIt->value, _topology));
+            feature.lines.push_back(getLine(arcsIt->value, _topology, _arena));
         }
     } else if (type == "MultiLineString") {
         feature.geometryType = GeometryType::lines;
@@ -196,14 +196,14 @@ Feature getFeature(const JsonValue& _geometry, const Topology& _topology, int32_
         if (arcsIt != _geometry.MemberEnd() && arcsIt->value.IsArray()) {
             auto& arcs = arcsIt->value;
             for (auto arcList = arcs.Begin(); arcList != arcs.End(); ++arcList) {
-                feature.lines.push_back(getLine(*arcList, _topology));
+                feature.lines.push_back(getLine(*arcList, _topology, _arena));
             }
         }
     } else if (type == "Polygon") {
         feature.geometryType = GeometryType::polygons;
         auto arcsIt = _geometry.FindMember(keyArcs);
         if (arcsIt != _geometry.MemberEnd()) {
-            feature.polygons.push_back(getPolygon(arcsIt->value, _topology));
+            feature.polygons.push_back(getPolygon(arcsIt->value, _topology, _arena));
         }
     } else if (type == "MultiPolygon") {
         feature.geometryType = GeometryType::polygons;
@@ -211,7 +211,7 @@ Feature getFeature(const JsonValue& _geometry, const Topology& _topology, int32_
         if (arcsIt != _geometry.MemberEnd() && arcsIt->value.IsArray()) {
             auto& arcs = arcsIt->value;
             for (auto arcList = arcs.Begin(); arcList != arcs.End(); ++arcList) {
-                feature.polygons.push_back(getPolygon(*arcList, _topology));
+                feature.polygons.push_back(getPolygon(*arcList, _topology, _arena));
             }
         }
     } else if (type == "GeometryCollection") {
@@ -222,7 +222,8 @@ Feature getFeature(const JsonValue& _geometry, const Topology& _topology, int32_
 
 }
 
-Layer getLayer(JsonValue::MemberIterator& _objectIt, const Topology& _topology, int32_t _source) {
+Layer getLayer(JsonValue::MemberIterator& _objectIt, const Topology& _topology, int32_t _source,
+               Arena* _arena) {
 
     Layer layer(_objectIt->name.GetString());
 
@@ -231,8 +232,9 @@ Layer getLayer(JsonValue::MemberIterator& _objectIt, const Topology& _topology,
     if (type != object.MemberEnd() && strcmp("GeometryCollection", type->value.GetString()) == 0) {
         auto geometries = object.FindMember("geometries");
         if (geometries != object.MemberEnd() && geometries->value.IsArray()) {
+            AtomCache keys;
             for (auto it = geometries->value.Begin(); it != geometries->value.End(); ++it) {
-                layer.features.push_back(getFeature(*it, _topology, _source));
+                layer.features.push_back(getFeature(*it, _topology, _source, keys, _arena));
             }
         }
     }
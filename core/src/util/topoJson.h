@@ -2,6 +2,7 @@
 
 #include "data/tileData.h"
 #include "glm/vec2.hpp"
+#include "util/atom.h"
 #include "util/json.h"
 #include <functional>
 
@@ -22,13 +23,18 @@ Topology getTopology(const JsonDocument& _document, const Transform& _proj);
 
 Point getPoint(const JsonValue& _coordinates, const Topology& _topology, glm::ivec2& _cursor);
 
-Line getLine(const JsonValue& _arcs, const Topology& _topology);
+// Geometry containers are allocated from @_arena, or the heap when nullptr
 
-Polygon getPolygon(const JsonValue& _arcs, const Topology& _topology);
+Line getLine(const JsonValue& _arcs, const Topology& _topology, Arena* _arena = nullptr);
 
-Feature getFeature(const JsonValue& _geometry, const Topology& _topology, int32_t _sourceId);
+Polygon getPolygon(const JsonValue& _arcs, const Topology& _topology, Arena* _arena = nullptr);
 
-Layer getLayer(JsonValue::MemberIterator& _object, const Topology& _topology, int32_t _sourceId);
+// Property keys are interned through @_keys, shared by the features of a layer
+Feature getFeature(const JsonValue& _geometry, const Topology& _topology, int32_t _sourceId,
+                   AtomCache& _keys, Arena* _arena = nullptr);
+
+Layer getLayer(JsonValue::MemberIterator& _object, const Topology& _topology, int32_t _sourceId,
+               Arena* _arena = nullptr);
 
 }
 
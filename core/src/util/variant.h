@@ -14,6 +14,7 @@
 #undef NDEBUG
 #endif
 
+#include <functional>
 #include <string>
 
 namespace Tangram {
@@ -44,4 +45,12 @@ class Value : public detail::Value {
     using Base::Base;
 };
 
+/* Hashes a Value with Value::visit(value, value_hash{}) */
+struct value_hash {
+    using result_type = size_t;
+    size_t operator()(const none_type&) const { return 0; }
+    size_t operator()(const double& _num) const { return std::hash<double>()(_num); }
+    size_t operator()(const std::string& _str) const { return std::hash<std::string>()(_str); }
+};
+
 }
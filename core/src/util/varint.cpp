@@ -0,0 +1,115 @@
+#include "varint.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define VARINT_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define VARINT_NEON
+#endif
+
+namespace Tangram {
+
+namespace Varint {
+
+static inline bool decodeOne(const uint8_t*& _p, const uint8_t* _end, uint32_t& _out) {
+    const uint8_t* p = _p;
+    uint64_t result = 0;
+
+    for (int shift = 0; shift < 70 && p < _end; shift += 7) {
+        uint8_t byte = *p++;
+        result |= uint64_t(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            _out = static_cast<uint32_t>(result);
+            _p = p;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t decodeScalar(const char*& _data, const char* _end, uint32_t* _out, size_t _count) {
+    auto* p = reinterpret_cast<const uint8_t*>(_data);
+    auto* end = reinterpret_cast<const uint8_t*>(_end);
+
+    size_t n = 0;
+    while (n < _count && decodeOne(p, end, _out[n])) { n++; }
+
+    _data = reinterpret_cast<const char*>(p);
+    return n;
+}
+
+#if defined(VARINT_SSE2) || defined(VARINT_NEON)
+
+/* Loads 16 bytes at @_p, writes them widened to @_out and returns how many of
+ * them, from the start, are complete single-byte varints */
+static inline int unpack16(const uint8_t* _p, uint32_t* _out) {
+
+#if defined(VARINT_SSE2)
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_p));
+    __m128i zero = _mm_setzero_si128();
+
+    __m128i lo = _mm_unpacklo_epi8(v, zero);
+    __m128i hi = _mm_unpackhi_epi8(v, zero);
+    auto* out = reinterpret_cast<__m128i*>(_out);
+    _mm_storeu_si128(out + 0, _mm_unpacklo_epi16(lo, zero));
+    _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(lo, zero));
+    _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(hi, zero));
+    _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(hi, zero));
+
+    int mask = _mm_movemask_epi8(v);
+    return mask ? __builtin_ctz(mask) : 16;
+#else
+    uint8x16_t v = vld1q_u8(_p);
+
+    uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+    uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+    vst1q_u32(_out + 0, vmovl_u16(vget_low_u16(lo)));
+    vst1q_u32(_out + 4, vmovl_u16(vget_high_u16(lo)));
+    vst1q_u32(_out + 8, vmovl_u16(vget_low_u16(hi)));
+    vst1q_u32(_out + 12, vmovl_u16(vget_high_u16(hi)));
+
+    if (vmaxvq_u8(v) < 0x80) { return 16; }
+
+    int run = 0;
+    while (!(_p[run] & 0x80)) { run++; }
+    return run;
+#endif
+}
+
+size_t decode(const char*& _data, const char* _end, uint32_t* _out, size_t _count) {
+    auto* p = reinterpret_cast<const uint8_t*>(_data);
+    auto* end = reinterpret_cast<const uint8_t*>(_end);
+
+    size_t n = 0;
+
+    while (_count - n >= 16 && end - p >= 16) {
+        // Values after the first multi-byte varint are overwritten below
+        int run = unpack16(p, _out + n);
+        p += run;
+        n += run;
+
+        if (run < 16) {
+            if (!decodeOne(p, end, _out[n])) {
+                _data = reinterpret_cast<const char*>(p);
+                return n;
+            }
+            n++;
+        }
+    }
+
+    _data = reinterpret_cast<const char*>(p);
+    return n + decodeScalar(_data, _end, _out + n, _count - n);
+}
+
+#else
+
+size_t decode(const char*& _data, const char* _end, uint32_t* _out, size_t _count) {
+    return decodeScalar(_data, _end, _out, _count);
+}
+
+#endif
+
+}
+
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Tangram {
+
+namespace Varint {
+
+    /* Decodes up to @_count protobuf varints from [@_data, @_end) into @_out
+     * and advances @_data past them. Values are truncated to 32 bits, as used
+     * by MVT geometry commands and parameters.
+     *
+     * Returns the number of values decoded, less than @_count when the buffer
+     * ends first or holds an unterminated varint.
+     *
+     * Runs of single-byte varints are unpacked 16 at a time with SSE2 or NEON
+     * when available. */
+    size_t decode(const char*& _data, const char* _end, uint32_t* _out, size_t _count);
+
+    /* Byte-at-a-time decoder, the fallback of decode() */
+    size_t decodeScalar(const char*& _data, const char* _end, uint32_t* _out, size_t _count);
+
+    inline int32_t zigzag(uint32_t _value) {
+        return static_cast<int32_t>(_value >> 1) ^ -static_cast<int32_t>(_value & 1);
+    }
+
+}
+
+}
@@ -11,6 +11,10 @@
 
 #define MAX_LOD 6
 
+// Number of points on the way to a prefetch destination for which the
+// tiles under the view center are added
+#define PREFETCH_PATH_SAMPLES 8
+
 namespace Tangram {
 
 double invLodFunc(double d) {
@@ -384,6 +388,60 @@ glm::vec2 View::lonLatToScreenPosition(double lon, double lat, bool& clipped) {
     return screenPosition;
 }
 
+void View::getPrefetchTiles(const glm::dvec2& _position, float _zoom, std::set<TileID>& _tiles) const {
+
+    _zoom = glm::clamp(_zoom, s_minZoom, s_maxZoom);
+
+    double hc = MapProjection::HALF_CIRCUMFERENCE;
+
+    auto addTile = [&](int x, int y, int z) {
+        if (_tiles.size() >= MAX_PREFETCH_TILES) { return; }
+
+        int maxTileIndex = 1 << z;
+        if (y < 0 || y >= maxTileIndex) { return; }
+
+        // Wrap x to the range [0, (1 << z)) like updateTiles()
+        int tileX = x & (maxTileIndex - 1);
+        int wrap = (x - tileX) >> z;
+
+        TileID id(tileX, y, z, z, wrap);
+        if (m_visibleTiles.find(id) == m_visibleTiles.end()) {
+            _tiles.insert(id);
+        }
+    };
+
+    auto toTile = [&](double _x, double _y, int _z) {
+        double invTileSize = double(1 << _z) / (hc * 2);
+        return glm::ivec2(std::floor((_x + hc) * invTileSize),
+                          std::floor((hc - _y) * invTileSize));
+    };
+
+    // Tiles covering the view at the destination. Rotation and tilt are not
+    // known ahead, so cover the circle around the longer side of the view.
+    int zoom = int(_zoom);
+    double radius = 0.5 * std::max(m_width, m_height) * exp2(m_zoom - _zoom);
+
+    glm::ivec2 min = toTile(_position.x - radius, _position.y + radius, zoom);
+    glm::ivec2 max = toTile(_position.x + radius, _position.y - radius, zoom);
+
+    for (int y = min.y; y <= max.y; y++) {
+        for (int x = min.x; x <= max.x; x++) {
+            addTile(x, y, zoom);
+        }
+    }
+
+    // Tiles under the view center along the way, from the destination back
+    for (int i = PREFETCH_PATH_SAMPLES - 1; i > 0; i--) {
+        double t = double(i) / PREFETCH_PATH_SAMPLES;
+        double x = m_pos.x + (_position.x - m_pos.x) * t;
+        double y = m_pos.y + (_position.y - m_pos.y) * t;
+        int z = int(m_zoom + (_zoom - m_zoom) * t);
+
+        glm::ivec2 tile = toTile(x, y, z);
+        addTile(tile.x, tile.y, z);
+    }
+}
+
 void View::updateTiles() {
 
     m_visibleTiles.clear();
@@ -159,6 +159,13 @@ public:
     /* Returns the set of all tiles visible at the current position and zoom */
     const std::set<TileID>& getVisibleTiles() { return m_visibleTiles; }
 
+    /* Adds tiles to @_tiles that will be needed when the view moves to @_position
+     * (in projection units) and zoom @_zoom: the tiles covering the view at the
+     * destination and the tiles under the view center along the way. Tiles that
+     * are currently visible are skipped, at most MAX_PREFETCH_TILES are added.
+     */
+    void getPrefetchTiles(const glm::dvec2& _position, float _zoom, std::set<TileID>& _tiles) const;
+
     /* Returns true if the view properties have changed since the last call to update() */
     bool changedOnLastUpdate() const { return m_changed; }
 
@@ -166,6 +173,7 @@ public:
     constexpr static float s_maxZoom = 20.5;
     constexpr static float s_minZoom = 0.0;
     constexpr static float s_pixelsPerTile = 256.0;
+    constexpr static size_t MAX_PREFETCH_TILES = 48;
 
     const glm::mat4& getOrthoViewportMatrix() const { return m_orthoViewport; };
 
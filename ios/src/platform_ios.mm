@@ -133,14 +133,14 @@ bool startUrlRequest(const std::string& _url, UrlCallback _callback) {
                 statusCode,
                 [[NSHTTPURLResponse localizedStringForStatusCode: statusCode] UTF8String],
                 [response.URL.absoluteString UTF8String]);
-            _callback(std::move(rawDataVec));
+            _callback(std::move(rawDataVec), false);
 
         } else {
 
             int dataLength = [data length];
             rawDataVec.resize(dataLength);
             memcpy(rawDataVec.data(), (char *)[data bytes], dataLength);
-            _callback(std::move(rawDataVec));
+            _callback(std::move(rawDataVec), true);
 
         }
 
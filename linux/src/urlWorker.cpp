@@ -6,9 +6,11 @@ static size_t write_data(void *_buffer, size_t _size, size_t _nmemb, void *_data
 
     const size_t realSize = _size * _nmemb;
 
-    std::stringstream* stream = (std::stringstream*)_dataPtr;
+    // Append to the buffer that is handed on to the callback, curl
+    // inflates gzip responses before they get here
+    std::vector<char>* content = (std::vector<char>*)_dataPtr;
 
-    stream->write((const char*)_buffer, realSize);
+    content->insert(content->end(), (const char*)_buffer, (const char*)_buffer + realSize);
 
     return realSize;
 }
@@ -32,7 +34,7 @@ void UrlWorker::perform(std::unique_ptr<UrlTask> _task) {
 
         // set up curl to perform fetch
         curl_easy_setopt(m_curlHandle, CURLOPT_WRITEFUNCTION, write_data);
-        curl_easy_setopt(m_curlHandle, CURLOPT_WRITEDATA, &m_stream);
+        curl_easy_setopt(m_curlHandle, CURLOPT_WRITEDATA, &m_task->content);
         curl_easy_setopt(m_curlHandle, CURLOPT_URL, m_task->url.c_str());
         curl_easy_setopt(m_curlHandle, CURLOPT_HEADER, 0L);
         curl_easy_setopt(m_curlHandle, CURLOPT_VERBOSE, 0L);
@@ -40,27 +42,19 @@ void UrlWorker::perform(std::unique_ptr<UrlTask> _task) {
 
         LOGD("Fetching URL: %s", m_task->url.c_str());
 
-        // Reset stream
-        m_stream.seekp(0);
-
         CURLcode result = curl_easy_perform(m_curlHandle);
 
         long httpStatusCode = 0;
         curl_easy_getinfo(m_curlHandle, CURLINFO_RESPONSE_CODE, &httpStatusCode);
 
-        if (result == CURLE_OK && httpStatusCode == 200) {
-            size_t nBytes = m_stream.tellp();
-            m_stream.seekp(0);
-
-            m_task->content.resize(nBytes);
-            m_stream.seekg(0);
-            m_stream.read(m_task->content.data(), nBytes);
-        } else {
+        bool success = result == CURLE_OK && httpStatusCode == 200;
+        if (!success) {
             LOGE("curl_easy_perform failed: %s - %d",
                  curl_easy_strerror(result), httpStatusCode);
+            m_task->content.clear();
         }
 
-        m_task->callback(std::move(m_task->content));
+        m_task->callback(std::move(m_task->content), success);
         m_task.reset();
 
         // Run processNetworkQueue() for pending tasks
@@ -3,7 +3,6 @@
 #include <future>
 #include <memory>
 #include <vector>
-#include <sstream>
 
 #include "platform.h"
 
@@ -39,7 +38,6 @@ class UrlWorker {
 
     private:
         std::unique_ptr<UrlTask> m_task;
-        std::stringstream m_stream;
         CURL* m_curlHandle = nullptr;
 
         std::future<bool> m_future;
@@ -0,0 +1,67 @@
+#include "catch.hpp"
+
+#include "util/arena.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace Tangram;
+
+TEST_CASE("Arena hands out aligned memory from shared blocks") {
+    Arena arena(1024);
+
+    auto* a = static_cast<char*>(arena.allocate(3, 1));
+    auto* b = arena.allocate(8, 8);
+    auto* c = arena.allocate(16, 16);
+
+    REQUIRE((reinterpret_cast<uintptr_t>(b) % 8) == 0);
+    REQUIRE((reinterpret_cast<uintptr_t>(c) % 16) == 0);
+    REQUIRE((static_cast<char*>(b) - a) >= 3);
+
+    REQUIRE(arena.numBlocks() == 1);
+    REQUIRE(arena.allocated() == 27);
+    REQUIRE(arena.reserved() == 1024);
+}
+
+TEST_CASE("Arena starts a new block when the current one is full") {
+    Arena arena(1024);
+
+    for (int i = 0; i < 8; i++) {
+        arena.allocate(200, 4);
+    }
+
+    REQUIRE(arena.numBlocks() == 2);
+    REQUIRE(arena.allocated() == 1600);
+}
+
+TEST_CASE("Arena gives large allocations a block of their own") {
+    Arena arena(1024);
+
+    auto* small = static_cast<char*>(arena.allocate(8, 8));
+    arena.allocate(4096, 8);
+    auto* next = static_cast<char*>(arena.allocate(8, 8));
+
+    REQUIRE(arena.numBlocks() == 2);
+    // The block of the small allocations is still in use
+    REQUIRE((next - small) == 8);
+}
+
+TEST_CASE("Containers with an ArenaAllocator use the arena or the heap") {
+    Arena arena(1024);
+
+    std::vector<int, ArenaAllocator<int>> inArena(&arena);
+    inArena.reserve(16);
+    for (int i = 0; i < 16; i++) { inArena.push_back(i); }
+
+    REQUIRE(arena.allocated() == 16 * sizeof(int));
+
+    std::vector<int, ArenaAllocator<int>> onHeap;
+    onHeap.assign(inArena.begin(), inArena.end());
+
+    REQUIRE(arena.allocated() == 16 * sizeof(int));
+    REQUIRE(onHeap == inArena);
+
+    // Moving keeps the arena of the source
+    auto moved = std::move(inArena);
+    REQUIRE(moved.get_allocator().arena == &arena);
+}
@@ -0,0 +1,56 @@
+#include "catch.hpp"
+
+#include "util/atom.h"
+#include "data/propertyItem.h"
+#include "data/properties.h"
+
+using namespace Tangram;
+
+TEST_CASE("Equal strings intern to the same Atom") {
+    Atom a = Atom::intern("kind");
+    Atom b = Atom::intern(std::string("ki") + "nd");
+    Atom c = Atom::intern("name");
+
+    REQUIRE(a == b);
+    REQUIRE(a != c);
+    REQUIRE(&a.str() == &b.str());
+    REQUIRE(a.str() == "kind");
+
+    REQUIRE(Atom() == Atom::intern(""));
+    REQUIRE(Atom().empty());
+}
+
+TEST_CASE("Atom::find does not intern unknown strings") {
+    REQUIRE(Atom::find("atom-test-never-interned").empty());
+
+    Atom a = Atom::intern("atom-test-interned");
+    REQUIRE(Atom::find("atom-test-interned") == a);
+}
+
+TEST_CASE("AtomCache interns like the global table") {
+    AtomCache cache;
+
+    Atom a = cache.intern("atom-cache-key");
+    REQUIRE(a == Atom::intern("atom-cache-key"));
+    REQUIRE(cache.intern("atom-cache-key") == a);
+    REQUIRE(cache.intern("atom-cache-other") != a);
+
+    cache.clear();
+    REQUIRE(cache.intern("atom-cache-key") == a);
+}
+
+TEST_CASE("Properties are found by string and by Atom") {
+    Properties props;
+    props.set("kind", "highway");
+    props.set("height", 12.0);
+
+    REQUIRE(props.getString(Atom::intern("kind")) == "highway");
+    REQUIRE(props.getString("kind") == "highway");
+
+    double height = 0;
+    REQUIRE(props.getNumber(Atom::intern("height"), height));
+    REQUIRE(height == 12.0);
+
+    REQUIRE(props.contains(Atom::intern("kind")));
+    REQUIRE(!props.contains(Atom::intern("population")));
+}
@@ -0,0 +1,79 @@
+#include "catch.hpp"
+
+#include "util/builders.h"
+
+#include <vector>
+
+using namespace Tangram;
+
+struct PolyLineVertex {
+    glm::vec3 coord;
+    glm::vec2 normal;
+    glm::vec2 uv;
+};
+
+static Line zigzag(size_t _points) {
+    Line line;
+    for (size_t i = 0; i < _points; i++) {
+        line.push_back({ 0.1f + 0.07f * i, (i % 2) ? 0.3f : 0.2f + 0.01f * i, 0.f });
+    }
+    return line;
+}
+
+static std::vector<PolyLineVertex> build(const Line& _line, PolyLineBuilder& _ctx) {
+    std::vector<PolyLineVertex> vertices;
+    Builders::buildPolyLine(_line, _ctx, [&](const glm::vec3& coord, const glm::vec2& normal, const glm::vec2& uv) {
+        vertices.push_back({ coord, normal, uv });
+    });
+    return vertices;
+}
+
+TEST_CASE("Builders::buildPolyLine extrudes segments like glm", "[Builders][core]") {
+    // Nine points: eight segments in two batches and one closing segment
+    Line line = zigzag(9);
+
+    PolyLineBuilder ctx({}, CapTypes::butt, JoinTypes::miter);
+    ctx.useTexCoords = true;
+
+    auto vertices = build(line, ctx);
+    REQUIRE(vertices.size() == 2 * line.size());
+
+    glm::vec2 first = glm::normalize(glm::vec2(line[1].y - line[0].y, line[0].x - line[1].x));
+    glm::vec2 last = glm::normalize(glm::vec2(line[8].y - line[7].y, line[7].x - line[8].x));
+
+    float distance = 0;
+    for (size_t i = 0; i < line.size() - 1; i++) {
+        distance += glm::distance(line[i], line[i + 1]);
+    }
+
+    REQUIRE(vertices.front().normal == first);
+    REQUIRE(vertices[vertices.size() - 2].normal == last);
+    REQUIRE(vertices.back().uv.y == distance);
+}
+
+TEST_CASE("Builders::buildPolyLine reuses the segments of the previous line", "[Builders][core]") {
+    Line line = zigzag(11);
+
+    PolyLineBuilder fill({}, CapTypes::butt, JoinTypes::miter, false, true);
+    fill.useTexCoords = true;
+    build(line, fill);
+
+    // Outline pass with another cap and join
+    fill.cap = CapTypes::round;
+    fill.join = JoinTypes::round;
+    fill.clear();
+    fill.reuseSegments = true;
+    auto reused = build(line, fill);
+
+    PolyLineBuilder outline({}, CapTypes::round, JoinTypes::round, false, true);
+    outline.useTexCoords = true;
+    auto built = build(line, outline);
+
+    REQUIRE(reused.size() == built.size());
+    REQUIRE(fill.indices == outline.indices);
+    for (size_t i = 0; i < built.size(); i++) {
+        REQUIRE(reused[i].coord == built[i].coord);
+        REQUIRE(reused[i].normal == built[i].normal);
+        REQUIRE(reused[i].uv == built[i].uv);
+    }
+}
@@ -0,0 +1,126 @@
+#include "catch.hpp"
+
+#include "yaml-cpp/yaml.h"
+#include "scene/decodePlan.h"
+#include "scene/sceneLoader.h"
+#include "scene/scene.h"
+
+using namespace Tangram;
+using YAML::Node;
+
+void loadLayers(Scene& scene, const std::string& layersYaml) {
+    Node layers = YAML::Load(layersYaml);
+    for (const auto& layer : layers) {
+        SceneLoader::loadLayer(layer, scene);
+    }
+}
+
+TEST_CASE("DecodePlan lists the collections of the layers of a source") {
+    Scene scene;
+    loadLayers(scene, R"END(
+        roads:
+            data: { source: osm }
+        landuse:
+            data: { source: osm, layer: [parks, water] }
+        pois:
+            data: { source: other }
+        )END");
+
+    DecodePlan plan(scene, "osm");
+
+    REQUIRE(plan.hasLayer("roads"));
+    REQUIRE(plan.hasLayer("parks"));
+    REQUIRE(plan.hasLayer("water"));
+    REQUIRE(!plan.hasLayer("landuse"));
+    REQUIRE(!plan.hasLayer("pois"));
+}
+
+TEST_CASE("DecodePlan lists the keys read by filters, text sources and functions") {
+    Scene scene;
+    loadLayers(scene, R"END(
+        roads:
+            data: { source: osm }
+            filter: { kind: highway, $zoom: { min: 10 } }
+            bridges:
+                filter: { any: [ { is_bridge: true }, { layer: { min: 1 } } ] }
+                draw:
+                    text:
+                        text_source: "name:en"
+            tunnels:
+                filter: function() { return feature.is_tunnel && feature['name:de']; }
+        )END");
+
+    DecodePlan plan(scene, "osm");
+
+    REQUIRE(!plan.allKeys());
+    REQUIRE(plan.hasKey("kind"));
+    REQUIRE(plan.hasKey("is_bridge"));
+    REQUIRE(plan.hasKey("layer"));
+    REQUIRE(plan.hasKey("name:en"));
+    REQUIRE(plan.hasKey("is_tunnel"));
+    REQUIRE(plan.hasKey("name:de"));
+    // Read by the styles by default
+    REQUIRE(plan.hasKey("name"));
+    REQUIRE(plan.hasKey("height"));
+
+    REQUIRE(!plan.hasKey("$zoom"));
+    REQUIRE(!plan.hasKey("population"));
+}
+
+TEST_CASE("DecodePlan keeps all keys when a function computes property names") {
+    Scene scene;
+    loadLayers(scene, R"END(
+        roads:
+            data: { source: osm }
+            filter: function() { var key = 'kind'; return feature[key] == 'highway'; }
+        )END");
+
+    DecodePlan plan(scene, "osm");
+
+    REQUIRE(plan.allKeys());
+    REQUIRE(plan.hasKey("population"));
+}
+
+TEST_CASE("DecodePlan keeps all keys when a function appends to a quoted property name") {
+    Scene scene;
+    loadLayers(scene, R"END(
+        places:
+            data: { source: osm }
+            draw:
+                text:
+                    text_source: function() { var lang = 'de'; return feature['name:' + lang]; }
+        )END");
+
+    DecodePlan plan(scene, "osm");
+
+    REQUIRE(plan.allKeys());
+    REQUIRE(plan.hasKey("name:de"));
+}
+
+TEST_CASE("DecodePlan keeps all keys for interactive features") {
+    Scene scene;
+    loadLayers(scene, R"END(
+        pois:
+            data: { source: osm }
+            draw:
+                points:
+                    interactive: true
+        )END");
+
+    DecodePlan plan(scene, "osm");
+
+    // Picking returns all properties of the feature
+    REQUIRE(plan.allKeys());
+    REQUIRE(plan.hasKey("population"));
+
+    Scene other;
+    loadLayers(other, R"END(
+        pois:
+            data: { source: osm }
+            draw:
+                text:
+                    interactive: function() { return feature.kind === 'cafe'; }
+        )END");
+
+    REQUIRE(DecodePlan(other, "osm").allKeys());
+}
@@ -0,0 +1,239 @@
+#include "catch.hpp"
+
+#include "data/diskCache.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace Tangram;
+
+#define CACHE_FILE "/tmp/tangram_diskcache_test.bin"
+#define CACHE_SIZE (1024 * 1024)
+
+std::vector<char> tileBytes(int _seed, size_t _size) {
+    std::vector<char> data(_size);
+    for (size_t i = 0; i < _size; i++) { data[i] = char(_seed + i * 7); }
+    return data;
+}
+
+RawBuffer tileData(int _seed, size_t _size) {
+    return RawBuffer(tileBytes(_seed, _size));
+}
+
+std::vector<char> bytes(const RawBuffer& _buffer) {
+    return std::vector<char>(_buffer.data(), _buffer.data() + _buffer.size());
+}
+
+std::shared_ptr<DiskCache> openCache() {
+    return std::make_shared<DiskCache>(CACHE_FILE, CACHE_SIZE);
+}
+
+TEST_CASE( "Keep tiles across sessions", "[DiskCache]" ) {
+    std::remove(CACHE_FILE);
+
+    uint64_t source = DiskCache::sourceKey("http://tiles/{z}/{x}/{y}.mvt");
+    uint64_t other = DiskCache::sourceKey("http://other/{z}/{x}/{y}.mvt");
+
+    {
+        auto cache = openCache();
+        REQUIRE(cache->isOpen());
+
+        cache->put(source, TileID(1, 2, 3), tileData(1, 1000));
+        cache->put(source, TileID(2, 2, 3), tileData(2, 2000));
+        cache->put(other, TileID(1, 2, 3), tileData(3, 3000));
+        // Replaces the first record
+        cache->put(source, TileID(1, 2, 3), tileData(4, 4000));
+
+        REQUIRE(cache->count() == 3);
+    }
+
+    auto cache = openCache();
+    REQUIRE(cache->count() == 3);
+
+    RawBuffer data;
+    REQUIRE(cache->get(source, TileID(1, 2, 3), data));
+    REQUIRE(bytes(data) == tileBytes(4, 4000));
+    REQUIRE(cache->get(other, TileID(1, 2, 3), data));
+    REQUIRE(bytes(data) == tileBytes(3, 3000));
+    REQUIRE(!cache->get(other, TileID(2, 2, 3), data));
+
+    std::remove(CACHE_FILE);
+}
+
+TEST_CASE( "Evict oldest tiles when the cache is full", "[DiskCache]" ) {
+    std::remove(CACHE_FILE);
+
+    uint64_t source = DiskCache::sourceKey("http://tiles/{z}/{x}/{y}.mvt");
+    size_t tileSize = 50 * 1024;
+
+    {
+        auto cache = openCache();
+        for (int i = 0; i < 50; i++) {
+            cache->put(source, TileID(i, 0, 10), tileData(i, tileSize));
+        }
+        REQUIRE(cache->usage() <= CACHE_SIZE);
+        REQUIRE(cache->count() < 50);
+    }
+
+    auto cache = openCache();
+    size_t count = cache->count();
+    REQUIRE(count > 0);
+    REQUIRE(count < 50);
+
+    RawBuffer data;
+    REQUIRE(!cache->get(source, TileID(0, 0, 10), data));
+    REQUIRE(cache->get(source, TileID(49, 0, 10), data));
+    REQUIRE(bytes(data) == tileBytes(49, tileSize));
+
+    // The newest tiles survive
+    for (int i = 50 - count; i < 50; i++) {
+        REQUIRE(cache->get(source, TileID(i, 0, 10), data));
+    }
+
+    std::remove(CACHE_FILE);
+}
+
+TEST_CASE( "Do not overwrite records that are still referenced", "[DiskCache]" ) {
+    std::remove(CACHE_FILE);
+
+    uint64_t source = DiskCache::sourceKey("http://tiles/{z}/{x}/{y}.mvt");
+    size_t tileSize = 50 * 1024;
+
+    auto cache = openCache();
+    cache->put(source, TileID(0, 0, 10), tileData(0, tileSize));
+
+    RawBuffer pinned;
+    REQUIRE(cache->get(source, TileID(0, 0, 10), pinned));
+
+    // Wrap around a few times
+    for (int i = 1; i < 100; i++) {
+        cache->put(source, TileID(i, 0, 10), tileData(i, tileSize));
+    }
+
+    REQUIRE(bytes(pinned) == tileBytes(0, tileSize));
+
+    RawBuffer data;
+    REQUIRE(cache->get(source, TileID(99, 0, 10), data));
+    REQUIRE(bytes(data) == tileBytes(99, tileSize));
+
+    std::remove(CACHE_FILE);
+}
+
+TEST_CASE( "Clear tiles of one source and ignore corrupt records", "[DiskCache]" ) {
+    std::remove(CACHE_FILE);
+
+    uint64_t source = DiskCache::sourceKey("http://tiles/{z}/{x}/{y}.mvt");
+    uint64_t other = DiskCache::sourceKey("http://other/{z}/{x}/{y}.mvt");
+
+    {
+        auto cache = openCache();
+        cache->put(source, TileID(0, 0, 1), tileData(1, 1000));
+        cache->put(other, TileID(0, 0, 1), tileData(2, 1000));
+        cache->clear(source);
+        cache->put(source, TileID(1, 0, 1), tileData(3, 1000));
+    }
+
+    {
+        auto cache = openCache();
+        RawBuffer data;
+        REQUIRE(!cache->get(source, TileID(0, 0, 1), data));
+        REQUIRE(cache->get(source, TileID(1, 0, 1), data));
+        REQUIRE(cache->get(other, TileID(0, 0, 1), data));
+    }
+
+    // Damage the data of the first remaining record
+    FILE* file = std::fopen(CACHE_FILE, "r+b");
+    REQUIRE(file != nullptr);
+    std::vector<char> content(CACHE_SIZE);
+    size_t size = std::fread(content.data(), 1, content.size(), file);
+    auto damaged = tileBytes(2, 1000);
+    auto pos = std::search(content.begin(), content.begin() + size,
+                           damaged.begin(), damaged.end());
+    REQUIRE(pos != content.begin() + size);
+    std::fseek(file, (pos - content.begin()) + 10, SEEK_SET);
+    std::fputc(0, file);
+    std::fclose(file);
+
+    auto cache = openCache();
+    RawBuffer data;
+    REQUIRE(cache->contains(other, TileID(0, 0, 1)));
+    REQUIRE(!cache->get(other, TileID(0, 0, 1), data));
+    REQUIRE(!cache->contains(other, TileID(0, 0, 1)));
+    REQUIRE(cache->get(source, TileID(1, 0, 1), data));
+
+    std::remove(CACHE_FILE);
+}
+
+TEST_CASE( "Load tiles on the disk reader thread", "[DiskCache]" ) {
+    std::remove(CACHE_FILE);
+
+    uint64_t source = DiskCache::sourceKey("http://tiles/{z}/{x}/{y}.mvt");
+
+    auto cache = openCache();
+    cache->put(source, TileID(1, 2, 3), tileData(1, 1000));
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::vector<RawBuffer> results;
+
+    auto done = [&](RawBuffer&& _data) {
+        std::lock_guard<std::mutex> lock(mutex);
+        results.push_back(std::move(_data));
+        condition.notify_one();
+    };
+
+    cache->load(source, TileID(1, 2, 3), done);
+    cache->load(source, TileID(2, 2, 3), done);
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&]{ return results.size() == 2; });
+    }
+
+    // Loads run in order
+    REQUIRE(bytes(results[0]) == tileBytes(1, 1000));
+    REQUIRE(results[1].empty());
+
+    results.clear();
+    std::remove(CACHE_FILE);
+}
+
+TEST_CASE( "Reopen the file of a detached cache", "[DiskCache]" ) {
+    std::remove(CACHE_FILE);
+
+    uint64_t source = DiskCache::sourceKey("http://tiles/{z}/{x}/{y}.mvt");
+
+    auto cache = openCache();
+    cache->put(source, TileID(1, 2, 3), tileData(1, 1000));
+
+    RawBuffer data;
+    REQUIRE(cache->get(source, TileID(1, 2, 3), data));
+
+    // The file is locked while the cache uses it
+    REQUIRE(!openCache()->isOpen());
+
+    cache->detach();
+
+    auto reopened = openCache();
+    REQUIRE(reopened->isOpen());
+    REQUIRE(reopened->count() == 1);
+
+    // Referenced records stay readable, the detached cache is not used anymore
+    REQUIRE(bytes(data) == tileBytes(1, 1000));
+    REQUIRE(!cache->get(source, TileID(1, 2, 3), data));
+    cache->put(source, TileID(2, 2, 3), tileData(2, 1000));
+    REQUIRE(!reopened->contains(source, TileID(2, 2, 3)));
+
+    data = RawBuffer();
+    cache.reset();
+
+    REQUIRE(reopened->get(source, TileID(1, 2, 3), data));
+    REQUIRE(bytes(data) == tileBytes(1, 1000));
+
+    std::remove(CACHE_FILE);
+}
@@ -0,0 +1,71 @@
+#include "catch.hpp"
+
+#include "data/downloadBudget.h"
+
+using namespace Tangram;
+
+TEST_CASE( "Count in-flight requests, also when they get canceled", "[DownloadBudget]" ) {
+    DownloadBudget budget;
+
+    REQUIRE(budget.limit() == DownloadBudget::DEFAULT_LIMIT);
+
+    auto request1 = budget.startRequest();
+    auto request2 = budget.startRequest();
+    REQUIRE(budget.inFlight() == 2);
+
+    request1->finish(1024, true);
+    request1.reset();
+    REQUIRE(budget.inFlight() == 1);
+
+    // Canceled: the callback holding the request is dropped
+    request2.reset();
+    REQUIRE(budget.inFlight() == 0);
+
+    auto stats = budget.stats();
+    REQUIRE(stats.completed == 1);
+    REQUIRE(stats.failed == 0);
+}
+
+TEST_CASE( "Fixed limit does not adapt", "[DownloadBudget]" ) {
+    DownloadBudget budget;
+    budget.setLimit(8);
+
+    budget.startRequest()->finish(0, false);
+
+    REQUIRE(budget.limit() == 8);
+    REQUIRE(budget.stats().failed == 1);
+}
+
+TEST_CASE( "Adaptive limit halves on failure, once per round trip", "[DownloadBudget]" ) {
+    DownloadBudget budget(8);
+    budget.setAdaptive(2, 16);
+
+    auto request1 = budget.startRequest();
+    auto request2 = budget.startRequest();
+
+    request1->finish(0, false);
+    REQUIRE(budget.limit() == 4);
+
+    // Started before the decrease
+    request2->finish(0, false);
+    REQUIRE(budget.limit() == 4);
+
+    budget.startRequest()->finish(0, false);
+    REQUIRE(budget.limit() == 2);
+
+    // Lower bound
+    budget.startRequest()->finish(0, false);
+    REQUIRE(budget.limit() == 2);
+}
+
+TEST_CASE( "Empty responses of successful requests are no congestion", "[DownloadBudget]" ) {
+    DownloadBudget budget(8);
+    budget.setAdaptive(2, 16);
+
+    // E.g. an empty ocean tile
+    budget.startRequest()->finish(0, true);
+
+    REQUIRE(budget.limit() == 8);
+    REQUIRE(budget.stats().failed == 0);
+    REQUIRE(budget.stats().completed == 1);
+}
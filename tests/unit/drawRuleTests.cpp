@@ -2,6 +2,8 @@
 
 #include "scene/drawRule.h"
 #include "scene/sceneLayer.h"
+#include "scene/stops.h"
+#include "scene/styleContext.h"
 #include "platform.h"
 
 #include <cstdio>
@@ -205,3 +207,37 @@ TEST_CASE("DrawRule correctly reports that it doesn't contain a parameter", "[Dr
 
 
 }
+
+TEST_CASE("DrawRuleMergeSet evaluates Stops once per zoom", "[DrawRule]") {
+
+    Stops stops({ Stops::Frame(0, 1.f), Stops::Frame(10, 11.f) });
+
+    std::vector<StyleParam> params = {
+        { StyleParamKey::order, "value_0a" },
+        { StyleParamKey::priority, &stops },
+    };
+    const SceneLayer layer = { "a", Filter(), { { "dg1", dg1, std::move(params) } }, {} };
+
+    StyleContext ctx;
+    ctx.setKeywordZoom(5);
+
+    DrawRuleMergeSet set;
+    set.mergeRules(layer);
+    DrawRule rule_a = set.matchedRules()[0];
+    DrawRule rule_b = set.matchedRules()[0];
+
+    REQUIRE(set.evaluateRule(rule_a, ctx));
+    REQUIRE(set.evaluateRule(rule_b, ctx));
+
+    // Both rules point to the same evaluated param
+    auto& param_a = rule_a.findParameter(StyleParamKey::priority);
+    REQUIRE(&param_a == &rule_b.findParameter(StyleParamKey::priority));
+    REQUIRE(param_a.value.is<float>());
+    REQUIRE(param_a.value.get<float>() == 6.f);
+
+    ctx.setKeywordZoom(10);
+
+    DrawRule rule_c = set.matchedRules()[0];
+    REQUIRE(set.evaluateRule(rule_c, ctx));
+    REQUIRE(rule_c.findParameter(StyleParamKey::priority).value.get<float>() == 11.f);
+}
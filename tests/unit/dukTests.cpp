@@ -109,6 +109,76 @@ TEST_CASE( "Test evalFilterFn with different features", "[Duktape][evalFilterFn]
     REQUIRE(ctx.evalFilter(0) == true);
 }
 
+TEST_CASE( "Test evalFilterFn reuses results for equal properties", "[Duktape][evalFilterFn]") {
+    StyleContext ctx;
+
+    REQUIRE(ctx.setFunctions({
+                R"(function() { return feature.kind === 'a' && $zoom > 10; })",
+                R"(function() { return Math.random() < 2 && feature.kind === 'a'; })"}));
+    ctx.setKeyword("$zoom", 12);
+
+    Feature feat1;
+    feat1.props.set("kind", "a");
+    feat1.props.set("id", 1);
+
+    Feature feat2;
+    feat2.props.set("kind", "a");
+    feat2.props.set("id", 2);
+
+    Feature feat3;
+    feat3.props.set("kind", "b");
+
+    ctx.setFeature(feat1);
+    REQUIRE(ctx.evalFilter(0) == true);
+    REQUIRE(ctx.evalFilter(1) == true);
+    REQUIRE(ctx.resultHits() == 0);
+
+    // Only 'kind' is read
+    ctx.setFeature(feat2);
+    REQUIRE(ctx.evalFilter(0) == true);
+    REQUIRE(ctx.resultHits() == 1);
+
+    ctx.setFeature(feat3);
+    REQUIRE(ctx.evalFilter(0) == false);
+    REQUIRE(ctx.resultHits() == 1);
+
+    // Impure functions are always called
+    ctx.setFeature(feat2);
+    REQUIRE(ctx.evalFilter(1) == true);
+    REQUIRE(ctx.resultHits() == 1);
+
+    // Changing keywords drops the results
+    ctx.setKeyword("$zoom", 8);
+    REQUIRE(ctx.evalFilter(0) == false);
+    REQUIRE(ctx.resultHits() == 1);
+}
+
+TEST_CASE( "Test evalStyleFn does not reuse results of computed property names", "[Duktape][evalStyleFn]") {
+    StyleContext ctx;
+
+    REQUIRE(ctx.setFunctions({
+                R"(function() { var lang = 'de'; return feature['name:' + lang] || feature.name; })"}));
+
+    Feature feat1;
+    feat1.props.set("name", "Munich");
+    feat1.props.set("name:de", "München");
+
+    Feature feat2;
+    feat2.props.set("name", "Munich");
+    feat2.props.set("name:de", "Muenchen");
+
+    StyleParam::Value value;
+
+    ctx.setFeature(feat1);
+    REQUIRE(ctx.evalStyle(0, StyleParamKey::text_source, value) == true);
+    REQUIRE(value.get<std::string>() == "München");
+
+    ctx.setFeature(feat2);
+    REQUIRE(ctx.evalStyle(0, StyleParamKey::text_source, value) == true);
+    REQUIRE(value.get<std::string>() == "Muenchen");
+    REQUIRE(ctx.resultHits() == 0);
+}
+
 TEST_CASE( "Test numeric keyword", "[Duktape][setKeyword]") {
     StyleContext ctx;
     ctx.setKeyword("$zoom", 10);
@@ -219,8 +289,9 @@ TEST_CASE( "Test evalStyleFn - StyleParamKey::extrude", "[Duktape][evalStyleFn]"
 
 TEST_CASE( "Test evalFilter - Init filter function from yaml", "[Duktape][evalFilter]") {
     Scene scene;
-    YAML::Node n0 = YAML::Load(R"(filter: function() { return feature.sort_key === 2; })");
-    YAML::Node n1 = YAML::Load(R"(filter: function() { return feature.name === 'test'; })");
+    // Loose comparisons are not translated to native filters
+    YAML::Node n0 = YAML::Load(R"(filter: function() { return feature.sort_key == 2; })");
+    YAML::Node n1 = YAML::Load(R"(filter: function() { return feature.name == 'test'; })");
 
     Filter filter0 = SceneLoader::generateFilter(n0["filter"], scene);
     Filter filter1 = SceneLoader::generateFilter(n1["filter"], scene);
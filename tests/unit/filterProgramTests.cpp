@@ -0,0 +1,72 @@
+#include "catch.hpp"
+
+#include "yaml-cpp/yaml.h"
+#include "data/tileData.h"
+#include "scene/filterProgram.h"
+#include "scene/sceneLoader.h"
+#include "scene/scene.h"
+#include "scene/styleContext.h"
+
+#include <functional>
+
+using namespace Tangram;
+using YAML::Node;
+
+static void visitLayers(const SceneLayer& _layer, const std::function<void(const SceneLayer&)>& _fn) {
+    _fn(_layer);
+    for (const auto& sublayer : _layer.sublayers()) { visitLayers(sublayer, _fn); }
+}
+
+TEST_CASE("FilterProgram evaluates like the filter trees of a layer", "[filters][core]") {
+    Scene scene;
+    Node layers = YAML::Load(R"END(
+        roads:
+            data: { source: osm }
+            filter: { kind: [highway, major_road, minor_road] }
+            highway:
+                filter: { kind: highway, $zoom: { min: 8 } }
+            bridges:
+                filter: { any: [ { is_bridge: true }, { layer: { min: 1 } } ] }
+                named:
+                    filter: { name: true, not: { kind: highway } }
+            tunnels:
+                filter: { all: [ { kind: [highway, major_road, minor_road] }, { is_tunnel: true } ] }
+        )END");
+    for (const auto& layer : layers) { SceneLoader::loadLayer(layer, scene); }
+
+    REQUIRE(scene.layers().size() == 1);
+    const auto& root = scene.layers()[0];
+    const auto* program = root.filterProgram();
+    REQUIRE(program != nullptr);
+
+    // The kind set of 'roads' and 'tunnels' is tested once
+    REQUIRE(program->numKeys() == 5);
+
+    StyleContext ctx;
+    ctx.setKeywordZoom(10);
+
+    std::vector<Feature> features(4);
+    features[0].props.set("kind", "highway");
+    features[0].props.set("is_bridge", "true");
+    features[1].props.set("kind", "minor_road");
+    features[1].props.set("layer", 2);
+    features[1].props.set("name", "Main St");
+    features[2].props.set("kind", "major_road");
+    features[2].props.set("is_tunnel", "true");
+    features[3].props.set("kind", "water");
+
+    FilterProgram::State state;
+    int matches = 0;
+
+    for (const auto& feature : features) {
+        ctx.setFeature(feature);
+        program->begin(state);
+
+        visitLayers(root, [&](const SceneLayer& layer) {
+            bool expected = layer.filter().eval(feature, ctx);
+            REQUIRE(program->eval(layer.filterId(), feature, ctx, state) == expected);
+            if (expected) { matches++; }
+        });
+    }
+    REQUIRE(matches > 0);
+}
@@ -0,0 +1,84 @@
+#include "catch.hpp"
+
+#include "data/tileData.h"
+#include "scene/filters.h"
+#include "scene/jsFunction.h"
+#include "scene/styleContext.h"
+
+using namespace Tangram;
+
+TEST_CASE("JsFunction::featureKeys lists the named feature properties", "[JsFunction][core]") {
+    std::vector<std::string> keys;
+
+    REQUIRE(JsFunction::featureKeys("function() { return feature.kind === 'a' && feature['name:de']; }", keys));
+    REQUIRE(keys.size() == 2);
+    REQUIRE(keys[0] == "kind");
+    REQUIRE(keys[1] == "name:de");
+
+    keys.clear();
+    REQUIRE(JsFunction::featureKeys("function() { return myfeature.kind + global.feature; }", keys));
+    REQUIRE(keys.empty());
+
+    keys.clear();
+    REQUIRE(!JsFunction::featureKeys("function() { var k = 'kind'; return feature[k]; }", keys));
+    REQUIRE(!JsFunction::featureKeys("function() { return 'kind' in feature; }", keys));
+    REQUIRE(!JsFunction::featureKeys("function() { return feature['name:' + global.lang]; }", keys));
+
+    keys.clear();
+    REQUIRE(JsFunction::featureKeys("function() { return feature[ 'name:de' ] + feature.name; }", keys));
+    REQUIRE(keys.size() == 2);
+    REQUIRE(keys[0] == "name:de");
+}
+
+TEST_CASE("JsFunction::isPure rejects functions reading the clock or random numbers", "[JsFunction][core]") {
+    REQUIRE(JsFunction::isPure("function() { return feature.height * 2; }"));
+    REQUIRE(!JsFunction::isPure("function() { return Math.random() > 0.5; }"));
+    REQUIRE(!JsFunction::isPure("function() { return new Date().getHours() > 18; }"));
+}
+
+TEST_CASE("JsFunction::translateFilter translates strict comparisons", "[JsFunction][core]") {
+    Feature highway;
+    highway.props.set("kind", "highway");
+    highway.props.set("lanes", 4);
+
+    Feature path;
+    path.props.set("kind", "path");
+    path.props.set("name", "Main St");
+
+    StyleContext ctx;
+
+    Filter filter;
+
+    REQUIRE(JsFunction::translateFilter("function() { return feature.kind === 'highway'; }", filter));
+    REQUIRE(filter.eval(highway, ctx));
+    REQUIRE(!filter.eval(path, ctx));
+
+    REQUIRE(JsFunction::translateFilter("function(){return 4===feature['lanes']}", filter));
+    REQUIRE(filter.eval(highway, ctx));
+    REQUIRE(!filter.eval(path, ctx));
+
+    REQUIRE(JsFunction::translateFilter(R"(function() {
+        return (feature.kind === "path" || feature.lanes === -1) && feature.name !== 'Elm St';
+    })", filter));
+    REQUIRE(!filter.eval(highway, ctx));
+    REQUIRE(filter.eval(path, ctx));
+
+    REQUIRE(JsFunction::translateFilter("function() { return feature.kind !== 'path'; }", filter));
+    REQUIRE(filter.eval(highway, ctx));
+    REQUIRE(!filter.eval(path, ctx));
+}
+
+TEST_CASE("JsFunction::translateFilter leaves other functions to JS", "[JsFunction][core]") {
+    Filter filter;
+
+    REQUIRE(!JsFunction::translateFilter("function() { return feature.kind == 'highway'; }", filter));
+    REQUIRE(!JsFunction::translateFilter("function() { return feature.lanes > 2; }", filter));
+    REQUIRE(!JsFunction::translateFilter("function() { return feature.kind === 'a\\'b'; }", filter));
+    REQUIRE(!JsFunction::translateFilter("function() { return feature.$zoom === 10; }", filter));
+    REQUIRE(!JsFunction::translateFilter("function() { return $zoom === 10; }", filter));
+    REQUIRE(!JsFunction::translateFilter("function() { return feature.kind === global.kind; }", filter));
+    REQUIRE(!JsFunction::translateFilter("function() { return feature.kind === 'a'; } // end", filter));
+    REQUIRE(!JsFunction::translateFilter("function() { var a = 1; return feature.n === a; }", filter));
+
+    REQUIRE(filter.data.is<none_type>());
+}
@@ -4,9 +4,14 @@
 #include "style/textStyle.h"
 #include "labels/textLabel.h"
 #include "labels/textLabels.h"
+#include "labels/spriteLabel.h"
+#include "style/pointStyle.h"
+#include "gl/vertexLayout.h"
 #include "glm/mat4x4.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 
+#include <cstring>
+
 #define EPSILON 0.00001
 
 using namespace Tangram;
@@ -178,3 +183,32 @@ TEST_CASE( "Sine interpolation", "[Core][Label][Fade]" ) {
     REQUIRE(fadeIn.isFinished());
 }
 
+TEST_CASE( "Sprite vertices pack the label alpha into 12 bytes", "[Core][Label][Sprite]" ) {
+    PointStyle style("points", nullptr);
+    style.constructVertexLayout();
+
+    auto& layout = *style.vertexLayout();
+    REQUIRE(sizeof(SpriteVertex) == 12);
+    REQUIRE(layout.getStride() == sizeof(SpriteVertex));
+    REQUIRE(layout.getOffset("a_position") == offsetof(SpriteVertex, pos));
+    REQUIRE(layout.getOffset("a_uv") == offsetof(SpriteVertex, uv));
+    REQUIRE(layout.getOffset("a_color") == offsetof(SpriteVertex, state));
+
+    // ABGR, as read by the normalized unsigned byte a_color attribute
+    uint32_t color = 0xc8332211;
+
+    auto unpack = [](float _alpha, uint32_t _color) {
+        SpriteVertex vertex;
+        vertex.state.color = SpriteVertex::packColor(_color, _alpha);
+
+        uint8_t bytes[sizeof(SpriteVertex)];
+        std::memcpy(bytes, &vertex, sizeof(vertex));
+        return std::vector<uint8_t>(bytes + offsetof(SpriteVertex, state),
+                                    bytes + sizeof(SpriteVertex));
+    };
+
+    REQUIRE(unpack(1.f, color) == (std::vector<uint8_t>{ 0x11, 0x22, 0x33, 0xc8 }));
+    REQUIRE(unpack(0.5f, color) == (std::vector<uint8_t>{ 0x11, 0x22, 0x33, 0x64 }));
+    REQUIRE(unpack(0.f, color) == (std::vector<uint8_t>{ 0x11, 0x22, 0x33, 0x00 }));
+    REQUIRE(unpack(0.3f, 0xff000000) == (std::vector<uint8_t>{ 0x00, 0x00, 0x00, 77 }));
+}
@@ -1,5 +1,6 @@
 #include "catch.hpp"
 
+#include "scene/dataLayer.h"
 #include "scene/sceneLayer.h"
 #include "data/tileData.h"
 #include "scene/styleContext.h"
@@ -88,6 +89,12 @@ SceneLayer instance() {
     return { "layer", f, { rule }, { instance_1(), instance_2() } };
 }
 
+// Layer trees are matched from their root DataLayer, which holds the
+// compiled filters
+DataLayer root(SceneLayer _layer) {
+    return { std::move(_layer), "", {} };
+}
+
 TEST_CASE("SceneLayer", "[SceneLayer][Filter][DrawRule][Match][Merge]") {
 
     Feature f1;
@@ -96,7 +103,7 @@ TEST_CASE("SceneLayer", "[SceneLayer][Filter][DrawRule][Match][Merge]") {
     Feature f4;
     Context ctx;
 
-    auto layer = instance();
+    auto layer = root(instance());
 
     {
         DrawRuleMergeSet ruleSet;
@@ -153,7 +160,7 @@ TEST_CASE("SceneLayer matches correct rules for a feature and context", "[SceneL
 
     {
         DrawRuleMergeSet ruleSet;
-        auto layer_a = instance_a();
+        auto layer_a = root(instance_a());
 
         ruleSet.match(feat, layer_a, ctx);
         auto& matches_a = ruleSet.matchedRules();
@@ -164,7 +171,7 @@ TEST_CASE("SceneLayer matches correct rules for a feature and context", "[SceneL
 
     {
         DrawRuleMergeSet ruleSet;
-        auto layer_b = instance_b();
+        auto layer_b = root(instance_b());
 
         ruleSet.match(feat, layer_b, ctx);
         auto& matches_b = ruleSet.matchedRules();
@@ -180,7 +187,7 @@ TEST_CASE("SceneLayer matches correct sublayer rules for a feature and context",
     Context ctx;
     DrawRuleMergeSet ruleSet;
 
-    auto layer_c = instance_c();
+    auto layer_c = root(instance_c());
 
     ruleSet.match(feat, layer_c, ctx);
     auto& matches = ruleSet.matchedRules();
@@ -198,7 +205,7 @@ TEST_CASE("SceneLayer correctly merges rules matched from sublayer", "[SceneLaye
     Context ctx;
     DrawRuleMergeSet ruleSet;
 
-    auto layer_e = instance_e();
+    auto layer_e = root(instance_e());
 
     ruleSet.match(feat, layer_e, ctx);
     auto& matches = ruleSet.matchedRules();
@@ -216,3 +223,41 @@ TEST_CASE("SceneLayer correctly merges rules matched from sublayer", "[SceneLaye
     REQUIRE(matches[0].findParameter(StyleParamKey::order).value.get<std::string>() == "value_c");
 
 }
+
+TEST_CASE("DrawRuleMergeSet reuses matches of features with equal filtered properties", "[SceneLayer][Filter][Match]") {
+
+    Context ctx;
+    DrawRuleMergeSet ruleSet;
+
+    auto layer = root(instance());
+
+    Feature a, b, c;
+    a.props.set("base", "blah");
+    a.props.set("one", "blah");
+    a.props.set("unfiltered", "a");
+
+    // Differs from 'a' only in a key no filter reads
+    b.props.set("base", "blah");
+    b.props.set("one", "blah");
+    b.props.set("unfiltered", "b");
+
+    c.props.set("base", "blah");
+    c.props.set("two", "blah");
+
+    REQUIRE(ruleSet.matchCached(a, layer, ctx));
+    REQUIRE(ruleSet.matchedRules().size() == 1);
+    REQUIRE(ruleSet.cacheMisses() == 1);
+
+    REQUIRE(ruleSet.matchCached(b, layer, ctx));
+    REQUIRE(ruleSet.matchedRules().size() == 1);
+    REQUIRE(ruleSet.matchedRules()[0].getStyleName() == "group1");
+    REQUIRE(ruleSet.cacheHits() == 1);
+
+    REQUIRE(ruleSet.matchCached(c, layer, ctx));
+    REQUIRE(ruleSet.matchedRules().size() == 2);
+    REQUIRE(ruleSet.cacheMisses() == 2);
+
+    ruleSet.clearCache();
+    REQUIRE(ruleSet.matchCached(b, layer, ctx));
+    REQUIRE(ruleSet.cacheMisses() == 3);
+}
@@ -0,0 +1,83 @@
+#include "catch.hpp"
+
+#include "data/rawCache.h"
+
+#include <vector>
+
+using namespace Tangram;
+
+RawBuffer rawData(size_t _size, char _value = 0) {
+    return RawBuffer(std::vector<char>(_size, _value));
+}
+
+TEST_CASE( "Cache raw tile data within the byte budget", "[RawCache]" ) {
+    RawCache cache;
+    size_t tileSize = 1024;
+    cache.setMaxUsage(RawCache::NUM_SHARDS * 8 * tileSize);
+
+    for (int i = 0; i < 1000; i++) {
+        cache.put(TileID(i % 100, i / 100, 10), rawData(tileSize));
+        REQUIRE(cache.usage() <= cache.maxUsage());
+    }
+
+    // The most recent tile is always kept
+    RawBuffer data;
+    REQUIRE(cache.get(TileID(99, 9, 10), data));
+    REQUIRE(data.size() == tileSize);
+    REQUIRE(!cache.get(TileID(0, 0, 10), data));
+
+    cache.clear();
+    REQUIRE(cache.usage() == 0);
+    REQUIRE(!cache.get(TileID(99, 9, 10), data));
+}
+
+TEST_CASE( "Replace cached tiles and ignore styling zoom and wrap", "[RawCache]" ) {
+    RawCache cache;
+    cache.setMaxUsage(1024 * 1024);
+
+    cache.put(TileID(1, 2, 3), rawData(100, 1));
+    cache.put(TileID(1, 2, 3), rawData(200, 2));
+    REQUIRE(cache.usage() == 200);
+
+    RawBuffer data;
+    REQUIRE(cache.get(TileID(1, 2, 3, 5, 1), data));
+    REQUIRE(data.size() == 200);
+    REQUIRE(data.data()[0] == 2);
+}
+
+TEST_CASE( "Disabled cache stores nothing", "[RawCache]" ) {
+    RawCache cache;
+
+    cache.put(TileID(1, 2, 3), rawData(100));
+
+    RawBuffer data;
+    REQUIRE(!cache.get(TileID(1, 2, 3), data));
+    REQUIRE(cache.usage() == 0);
+}
+
+TEST_CASE( "Cache tiles larger than a shard's share of the budget", "[RawCache]" ) {
+    RawCache cache;
+    size_t maxUsage = RawCache::NUM_SHARDS * 1024;
+    cache.setMaxUsage(maxUsage);
+
+    for (int i = 0; i < 100; i++) {
+        cache.put(TileID(i, 0, 10), rawData(512));
+    }
+
+    // Evicts tiles of other shards to make room
+    cache.put(TileID(0, 1, 10), rawData(maxUsage / 2));
+    REQUIRE(cache.usage() <= maxUsage);
+
+    RawBuffer data;
+    REQUIRE(cache.get(TileID(0, 1, 10), data));
+    REQUIRE(data.size() == maxUsage / 2);
+
+    // Up to the whole budget
+    cache.put(TileID(0, 2, 10), rawData(maxUsage));
+    REQUIRE(cache.usage() == maxUsage);
+    REQUIRE(cache.get(TileID(0, 2, 10), data));
+    REQUIRE(!cache.get(TileID(0, 1, 10), data));
+
+    cache.put(TileID(0, 3, 10), rawData(maxUsage + 1));
+    REQUIRE(!cache.get(TileID(0, 3, 10), data));
+}
@@ -0,0 +1,79 @@
+#include "catch.hpp"
+
+#include "data/propertyItem.h"
+#include "util/simplify.h"
+
+using namespace Tangram;
+
+TEST_CASE("Simplifier removes points closer than the tolerance", "[Simplifier][core]") {
+    Line line;
+    for (int i = 0; i <= 10; i++) {
+        // Jitter of 0.001 along a straight line
+        line.push_back({ 0.1f + 0.05f * i, 0.5f + ((i % 2) ? 0.001f : 0.f), 0.f });
+    }
+    // Corner
+    line.push_back({ 0.6f, 0.9f, 0.f });
+
+    Simplifier simplifier(0.01f);
+    REQUIRE(simplifier.simplify(line) == 9);
+
+    REQUIRE(line.size() == 3);
+    REQUIRE(line[0] == Point(0.1f, 0.5f, 0.f));
+    REQUIRE(line[1] == Point(0.6f, 0.5f, 0.f));
+    REQUIRE(line[2] == Point(0.6f, 0.9f, 0.f));
+
+    Line detailed;
+    detailed.push_back({ 0.1f, 0.1f, 0.f });
+    detailed.push_back({ 0.2f, 0.15f, 0.f });
+    detailed.push_back({ 0.3f, 0.1f, 0.f });
+
+    REQUIRE(simplifier.simplify(detailed) == 0);
+    REQUIRE(detailed.size() == 3);
+}
+
+TEST_CASE("Simplifier keeps points outside of the tile", "[Simplifier][core]") {
+    Line line;
+    line.push_back({ 0.5f, 0.5f, 0.f });
+    line.push_back({ 0.75f, 0.5f, 0.f });
+    line.push_back({ 1.0001f, 0.5f, 0.f });
+    line.push_back({ 1.2f, 0.5f, 0.f });
+
+    Simplifier simplifier(0.01f);
+    REQUIRE(simplifier.simplify(line) == 1);
+    REQUIRE(line.size() == 3);
+    REQUIRE(line[1].x == 1.0001f);
+}
+
+TEST_CASE("Simplifier keeps polygon rings closed", "[Simplifier][core]") {
+    TileData tileData;
+    tileData.layers.emplace_back("buildings");
+
+    Feature feature;
+    feature.geometryType = GeometryType::polygons;
+    feature.polygons.emplace_back();
+
+    // A tiny ring that collapses below four points is left alone
+    Line tiny = { { 0.5f, 0.5f, 0.f }, { 0.501f, 0.5f, 0.f }, { 0.501f, 0.501f, 0.f },
+                  { 0.5f, 0.501f, 0.f }, { 0.5f, 0.5f, 0.f } };
+
+    // A square with a point on each side
+    Line square = { { 0.1f, 0.1f, 0.f }, { 0.2f, 0.1001f, 0.f }, { 0.3f, 0.1f, 0.f },
+                    { 0.3f, 0.2f, 0.f }, { 0.3001f, 0.3f, 0.f }, { 0.2f, 0.3f, 0.f },
+                    { 0.1f, 0.3f, 0.f }, { 0.1f, 0.1f, 0.f } };
+
+    feature.polygons[0].push_back(square);
+    feature.polygons[0].push_back(tiny);
+    tileData.layers[0].features.push_back(std::move(feature));
+
+    Simplifier simplifier(0.01f);
+    SimplifyStats stats;
+    simplifier.simplify(tileData, stats);
+
+    auto& polygon = tileData.layers[0].features[0].polygons[0];
+    REQUIRE(polygon[0].size() == 5);
+    REQUIRE(polygon[0].front() == polygon[0].back());
+    REQUIRE(polygon[1].size() == 5);
+
+    REQUIRE(stats.points == 13);
+    REQUIRE(stats.removed == 3);
+}
@@ -0,0 +1,101 @@
+#include "catch.hpp"
+
+#include "util/builders.h"
+#include "util/tessellationCache.h"
+
+#include <vector>
+
+using namespace Tangram;
+
+static Polygon square(float _x, float _y, float _size) {
+    Polygon polygon;
+    polygon.emplace_back();
+    polygon[0].push_back({ _x, _y, 0.f });
+    polygon[0].push_back({ _x + _size, _y, 0.f });
+    polygon[0].push_back({ _x + _size, _y + _size, 0.f });
+    polygon[0].push_back({ _x, _y + _size, 0.f });
+    polygon[0].push_back({ _x, _y, 0.f });
+    return polygon;
+}
+
+TEST_CASE("TessellationCache finds polygons with the same coordinates", "[TessellationCache][core]") {
+    TessellationCache cache;
+    cache.setMaxUsage(1024 * 1024);
+
+    Polygon a = square(0.1f, 0.1f, 0.2f);
+    Polygon b = square(0.1f, 0.1f, 0.2f);
+    Polygon c = square(0.1f, 0.1f, 0.3f);
+
+    REQUIRE(TessellationCache::hash(a) == TessellationCache::hash(b));
+
+    std::vector<uint16_t> indices = { 0, 1, 2, 0, 2, 3 };
+    cache.put(a, TessellationCache::hash(a), indices);
+
+    std::vector<uint16_t> result;
+    REQUIRE(cache.get(b, TessellationCache::hash(b), result));
+    REQUIRE(result == indices);
+
+    // Another polygon is not taken for a cached one with the same hash
+    REQUIRE(!cache.get(c, TessellationCache::hash(a), result));
+
+    REQUIRE(cache.hits() == 1);
+    REQUIRE(cache.misses() == 1);
+
+    cache.clear();
+    REQUIRE(cache.usage() == 0);
+    REQUIRE(!cache.get(b, TessellationCache::hash(b), result));
+}
+
+TEST_CASE("TessellationCache stays within its memory limit", "[TessellationCache][core]") {
+    TessellationCache cache;
+    cache.setMaxUsage(16 * 1024);
+
+    std::vector<uint16_t> indices = { 0, 1, 2, 0, 2, 3 };
+    for (int i = 0; i < 1000; i++) {
+        Polygon polygon = square(0.001f * i, 0.f, 0.1f);
+        cache.put(polygon, TessellationCache::hash(polygon), indices);
+
+        REQUIRE(cache.usage() <= cache.maxUsage());
+    }
+    REQUIRE(cache.usage() > 0);
+
+    cache.setMaxUsage(0);
+    Polygon polygon = square(0.f, 0.f, 0.1f);
+    std::vector<uint16_t> result;
+    REQUIRE(!cache.get(polygon, TessellationCache::hash(polygon), result));
+}
+
+TEST_CASE("Builders::buildPolygon gives the same triangles with a TessellationCache", "[TessellationCache][core]") {
+    Polygon polygon = square(0.2f, 0.2f, 0.5f);
+    polygon.emplace_back();
+    polygon[1].push_back({ 0.3f, 0.3f, 0.f });
+    polygon[1].push_back({ 0.3f, 0.4f, 0.f });
+    polygon[1].push_back({ 0.4f, 0.4f, 0.f });
+    polygon[1].push_back({ 0.3f, 0.3f, 0.f });
+
+    std::vector<glm::vec3> vertices;
+    auto addVertex = [&](const glm::vec3& coord, const glm::vec3&, const glm::vec2&) {
+        vertices.push_back(coord);
+    };
+
+    PolygonBuilder builder;
+    builder.useTexCoords = false;
+    Builders::buildPolygon(polygon, 1.f, builder, addVertex);
+
+    auto indices = builder.indices;
+    auto coords = vertices;
+
+    TessellationCache cache;
+    cache.setMaxUsage(1024 * 1024);
+    builder.cache = &cache;
+
+    for (int i = 0; i < 2; i++) {
+        builder.clear();
+        vertices.clear();
+        Builders::buildPolygon(polygon, 1.f, builder, addVertex);
+
+        REQUIRE(builder.indices == indices);
+        REQUIRE(vertices == coords);
+    }
+    REQUIRE(cache.hits() == 1);
+}
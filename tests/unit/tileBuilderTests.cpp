@@ -0,0 +1,178 @@
+#include "catch.hpp"
+
+#include "yaml-cpp/yaml.h"
+#include "data/dataSource.h"
+#include "data/tileData.h"
+#include "labels/labelSet.h"
+#include "labels/spriteLabel.h"
+#include "labels/textLabel.h"
+#include "labels/textLabels.h"
+#include "scene/sceneLoader.h"
+#include "scene/scene.h"
+#include "style/pointStyleBuilder.h"
+#include "style/style.h"
+#include "tile/tile.h"
+#include "tile/tileBuilder.h"
+
+#include <thread>
+
+using namespace Tangram;
+
+static std::shared_ptr<Scene> loadScene() {
+    auto scene = std::make_shared<Scene>();
+
+    YAML::Node config = YAML::Load(R"END(
+        sources:
+            osm:
+                type: GeoJSON
+                url: http://localhost/{z}/{x}/{y}.json
+        layers:
+            pois:
+                data: { source: osm }
+                draw:
+                    points:
+                        color: red
+                        size: 6px
+                    text:
+                        font: { fill: black, size: 12px }
+            roads:
+                data: { source: osm }
+                draw:
+                    lines:
+                        color: white
+                        width: 2px
+                        order: 1
+            buildings:
+                data: { source: osm }
+                draw:
+                    polygons:
+                        color: gray
+                        order: 0
+        )END");
+
+    SceneLoader::applyConfig(config, *scene);
+    return scene;
+}
+
+// Enough features for four partitions
+static TileData makeTileData(int _count) {
+    TileData data;
+    data.layers.emplace_back("pois");
+    data.layers.emplace_back("roads");
+    data.layers.emplace_back("buildings");
+
+    for (int i = 0; i < _count; i++) {
+        float x = (i % 32) / 32.f;
+        float y = (i / 32 % 32) / 32.f;
+        float d = 1.f / 64.f;
+
+        Feature poi;
+        poi.geometryType = GeometryType::points;
+        poi.points.push_back({x, y, 0});
+        poi.props.set("name", "poi " + std::to_string(i));
+        data.layers[0].features.push_back(std::move(poi));
+
+        Feature road;
+        road.geometryType = GeometryType::lines;
+        road.lines.emplace_back(Line{{x, y, 0}, {x + d, y + d, 0}});
+        data.layers[1].features.push_back(std::move(road));
+
+        Feature building;
+        building.geometryType = GeometryType::polygons;
+        building.polygons.emplace_back(Polygon{Line{{x, y, 0}, {x + d, y, 0}, {x + d, y + d, 0},
+                                                    {x, y + d, 0}, {x, y, 0}}});
+        data.layers[2].features.push_back(std::move(building));
+    }
+    return data;
+}
+
+static void requireEqualLabels(const LabelSet& _serial, const LabelSet& _parallel) {
+    const auto& serial = _serial.getLabels();
+    const auto& parallel = _parallel.getLabels();
+
+    REQUIRE(serial.size() == parallel.size());
+
+    for (size_t i = 0; i < serial.size(); i++) {
+        REQUIRE(serial[i]->type() == parallel[i]->type());
+        REQUIRE(serial[i]->transform().modelPosition1 == parallel[i]->transform().modelPosition1);
+
+        if (auto* text = dynamic_cast<TextLabel*>(serial[i].get())) {
+            auto* other = dynamic_cast<TextLabel*>(parallel[i].get());
+            REQUIRE(other);
+            REQUIRE(text->quadRange().start == other->quadRange().start);
+            REQUIRE(text->quadRange().length == other->quadRange().length);
+        } else if (auto* sprite = dynamic_cast<SpriteLabel*>(serial[i].get())) {
+            auto* other = dynamic_cast<SpriteLabel*>(parallel[i].get());
+            REQUIRE(other);
+            REQUIRE(sprite->quadIndex() == other->quadIndex());
+        }
+    }
+}
+
+static void requireEqualQuads(const StyledMesh* _serial, const StyledMesh* _parallel) {
+    REQUIRE(bool(_serial) == bool(_parallel));
+
+    if (auto* text = dynamic_cast<const TextLabels*>(_serial)) {
+        REQUIRE(text->quads.size() == static_cast<const TextLabels*>(_parallel)->quads.size());
+    }
+    if (auto* sprites = dynamic_cast<const SpriteLabels*>(_serial)) {
+        REQUIRE(sprites->quads.size() == static_cast<const SpriteLabels*>(_parallel)->quads.size());
+    }
+}
+
+TEST_CASE("A partitioned tile build matches the serial build", "[TileBuilder]") {
+    auto scene = loadScene();
+    auto source = scene->getDataSource("osm");
+    REQUIRE(source);
+
+    TileData data = makeTileData(1024);
+    TileID tileID(0, 0, 10);
+
+    TileBuilder serialBuilder(scene);
+    auto serial = serialBuilder.build(tileID, data, *source);
+    REQUIRE(serial);
+
+    TileBuilder parallelBuilder(scene);
+    parallelBuilder.setParallel(4, [](std::vector<std::function<void()>>& _jobs) {
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < _jobs.size(); i++) {
+            threads.emplace_back(_jobs[i]);
+        }
+        _jobs[0]();
+        for (auto& thread : threads) { thread.join(); }
+    });
+
+    // Twice, to also check the builders that are reused for the next tile
+    for (int pass = 0; pass < 2; pass++) {
+        auto parallel = parallelBuilder.build(tileID, data, *source);
+        REQUIRE(parallel);
+
+        size_t numLabels = 0;
+
+        for (const auto& style : scene->styles()) {
+            auto& a = serial->getMesh(*style);
+            auto& b = parallel->getMesh(*style);
+
+            REQUIRE(bool(a) == bool(b));
+            if (!a) { continue; }
+
+            REQUIRE(a->numVertices() == b->numVertices());
+            REQUIRE(a->numIndices() == b->numIndices());
+
+            if (auto* labels = dynamic_cast<LabelSet*>(a.get())) {
+                requireEqualLabels(*labels, dynamic_cast<LabelSet&>(*b));
+                numLabels += labels->getLabels().size();
+            }
+
+            if (auto* icons = dynamic_cast<IconMesh*>(a.get())) {
+                auto& other = static_cast<IconMesh&>(*b);
+                requireEqualQuads(icons->spriteLabels.get(), other.spriteLabels.get());
+                requireEqualQuads(icons->textLabels.get(), other.textLabels.get());
+            } else {
+                requireEqualQuads(a.get(), b.get());
+            }
+        }
+
+        REQUIRE(numLabels > 0);
+    }
+}
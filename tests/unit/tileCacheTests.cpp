@@ -0,0 +1,160 @@
+#include "catch.hpp"
+
+#include "style/polygonStyle.h"
+#include "tile/tileCache.h"
+#include "util/mapProjection.h"
+
+using namespace Tangram;
+
+#define TILE_SIZE 1000
+
+struct TestMesh : StyledMesh {
+    size_t size;
+    TestMesh(size_t _size) : size(_size) {}
+    bool draw(ShaderProgram& _shader) override { return false; }
+    size_t bufferSize() const override { return size; }
+};
+
+struct TestLabels : StyledMesh {
+    size_t size;
+    TestLabels(size_t _size) : size(_size) {}
+    bool draw(ShaderProgram& _shader) override { return false; }
+    size_t bufferSize() const override { return 0; }
+    void addMemoryUsage(MemoryUsage& _usage) const override { _usage.labels += size; }
+};
+
+static MercatorProjection s_projection;
+
+std::shared_ptr<Tile> makeTile(TileID _id, size_t _size = TILE_SIZE) {
+    static PolygonStyle style("test");
+    style.setID(0);
+
+    auto tile = std::make_shared<Tile>(_id, s_projection);
+    tile->setMesh(style, std::make_unique<TestMesh>(_size));
+    return tile;
+}
+
+TEST_CASE( "Frequently used tiles survive a scan", "[TileCache]" ) {
+    TileCache cache(100 * TILE_SIZE);
+
+    // Low zoom tiles that the view keeps coming back to
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 20; i++) {
+            TileID id(i % 8, i / 8, 3);
+            auto tile = cache.get(0, id);
+            cache.put(0, tile ? tile : makeTile(id));
+        }
+    }
+    REQUIRE(cache.getStats(3).requests == 60);
+    REQUIRE(cache.getStats(3).hits == 40);
+
+    // One-off scan through many high zoom tiles
+    for (int i = 0; i < 500; i++) {
+        TileID id(i, 0, 16);
+        cache.get(0, id);
+        cache.put(0, makeTile(id));
+    }
+    REQUIRE(cache.getMemoryUsage() <= 100 * TILE_SIZE);
+
+    int hits = 0;
+    for (int i = 0; i < 20; i++) {
+        if (cache.get(0, TileID(i % 8, i / 8, 3))) { hits++; }
+    }
+    REQUIRE(hits >= 18);
+
+    // Recently scanned tiles are still in the window
+    REQUIRE(bool(cache.contains(0, TileID(499, 0, 16))));
+}
+
+TEST_CASE( "Admit tiles that are used at least as often as the main cache victim", "[TileCache]" ) {
+    // Window of one tile, main cache of nine
+    {
+        TileCache cache(10 * TILE_SIZE);
+
+        for (int i = 0; i < 11; i++) {
+            cache.put(0, makeTile(TileID(i, 0, 10)));
+        }
+
+        // Tile 9 left the window and was used as often as tile 0, the least
+        // recently used tile of the main cache: the tie is admitted
+        REQUIRE(bool(cache.contains(0, TileID(9, 0, 10))));
+        REQUIRE(!cache.contains(0, TileID(0, 0, 10)));
+    }
+    {
+        TileCache cache(10 * TILE_SIZE);
+
+        // Requested before, more often than the other tiles
+        cache.get(0, TileID(0, 0, 10));
+        cache.get(0, TileID(0, 0, 10));
+
+        for (int i = 0; i < 11; i++) {
+            cache.put(0, makeTile(TileID(i, 0, 10)));
+        }
+
+        REQUIRE(bool(cache.contains(0, TileID(0, 0, 10))));
+        REQUIRE(!cache.contains(0, TileID(9, 0, 10)));
+    }
+}
+
+TEST_CASE( "Probing for proxy tiles counts no requests", "[TileCache]" ) {
+    TileCache cache(10 * TILE_SIZE);
+
+    // Probes of a tile before it is cached, as for proxies of visible tiles
+    cache.contains(0, TileID(0, 0, 10));
+    cache.contains(0, TileID(0, 0, 10));
+
+    for (int i = 0; i < 11; i++) {
+        cache.put(0, makeTile(TileID(i, 0, 10)));
+    }
+
+    // Tile 0 is not more frequent than tile 9
+    REQUIRE(bool(cache.contains(0, TileID(9, 0, 10))));
+    REQUIRE(!cache.contains(0, TileID(0, 0, 10)));
+
+    REQUIRE(cache.getStats(10).requests == 0);
+    REQUIRE(cache.getTotalStats().requests == 0);
+}
+
+TEST_CASE( "Track usage and evict when the limit is reduced", "[TileCache]" ) {
+    TileCache cache(100 * TILE_SIZE);
+
+    for (int i = 0; i < 50; i++) {
+        REQUIRE(cache.put(0, makeTile(TileID(i, 0, 10))).empty());
+    }
+    REQUIRE(cache.getMemoryUsage() == 50 * TILE_SIZE);
+
+    auto evicted = cache.limitCacheSize(20 * TILE_SIZE);
+    REQUIRE(evicted.size() == 30);
+    REQUIRE(cache.getMemoryUsage() == 20 * TILE_SIZE);
+
+    auto tile = cache.get(0, TileID(49, 0, 10));
+    REQUIRE(bool(tile));
+    REQUIRE(cache.getMemoryUsage() == 19 * TILE_SIZE);
+    REQUIRE(!cache.contains(0, TileID(49, 0, 10)));
+
+    cache.clear();
+    REQUIRE(cache.getMemoryUsage() == 0);
+}
+
+TEST_CASE( "Evict against the memory of all categories", "[TileCache]" ) {
+    static PolygonStyle labelStyle("labels");
+    labelStyle.setID(1);
+
+    TileCache cache(10 * TILE_SIZE);
+
+    for (int i = 0; i < 10; i++) {
+        auto tile = makeTile(TileID(i, 0, 10));
+        tile->setMesh(labelStyle, std::make_unique<TestLabels>(TILE_SIZE / 2));
+        REQUIRE(tile->getMemoryUsage() == TILE_SIZE + TILE_SIZE / 2);
+
+        cache.put(0, tile);
+    }
+
+    auto& usage = cache.getMemoryBreakdown();
+    REQUIRE(cache.getMemoryUsage() <= 10 * TILE_SIZE);
+    REQUIRE(usage.total() == cache.getMemoryUsage());
+    REQUIRE(usage.gpuBuffers == 2 * usage.labels);
+
+    cache.clear();
+    REQUIRE(cache.getMemoryBreakdown().total() == 0);
+}
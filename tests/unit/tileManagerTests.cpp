@@ -272,3 +272,37 @@ TEST_CASE( "Use proxy Tile - circular proxies", "[TileManager][updateTileSets]"
     REQUIRE(tileManager.getVisibleTiles()[0]->getID() == TileID(0,0,0));
 
 }
+
+TEST_CASE( "Load predicted tiles without showing them, drop them when the prediction changes", "[TileManager][prefetch]" ) {
+    TestTileWorker worker;
+    TileManager tileManager(worker);
+    ViewState viewState { s_projection, true, glm::vec2(0), 1 };
+
+    auto source = std::make_shared<TestDataSource>();
+    std::vector<std::shared_ptr<DataSource>> sources = { source };
+    tileManager.setDataSources(sources);
+
+    std::set<TileID> visibleTiles = { TileID{0,0,1} };
+    std::set<TileID> prefetchTiles = { TileID{1,0,1} };
+    tileManager.updateTileSets(viewState, visibleTiles, prefetchTiles);
+
+    REQUIRE(source->tileTaskCount == 2);
+    REQUIRE(worker.tasks.size() == 2);
+    REQUIRE(worker.tasks[0]->isPrefetch() == false);
+    REQUIRE(worker.tasks[1]->isPrefetch() == true);
+
+    worker.processTask();
+    worker.processTask();
+    tileManager.updateTileSets(viewState, visibleTiles, prefetchTiles);
+
+    // Only the visible tile is drawn, the predicted one is kept
+    REQUIRE(tileManager.getVisibleTiles().size() == 1);
+    REQUIRE(tileManager.getVisibleTiles()[0]->getID() == TileID(0,0,1));
+    REQUIRE(tileManager.getTileSets()[0].tiles.size() == 2);
+
+    /// Prediction changed
+    tileManager.updateTileSets(viewState, visibleTiles);
+
+    REQUIRE(tileManager.getTileSets()[0].tiles.size() == 1);
+    REQUIRE(bool(tileManager.getTileCache()->contains(source->id(), TileID(1,0,1))));
+}
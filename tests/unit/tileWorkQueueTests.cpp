@@ -0,0 +1,139 @@
+#include "catch.hpp"
+
+#include "data/dataSource.h"
+#include "tile/tileTask.h"
+#include "tile/tileWorkQueue.h"
+
+#include <vector>
+
+using namespace Tangram;
+
+struct QueueTestSource : DataSource {
+    QueueTestSource() : DataSource("", "") {}
+
+    std::shared_ptr<TileData> parse(const TileTask& _task,
+                                    const MapProjection& _projection) const override {
+        return nullptr;
+    }
+};
+
+std::shared_ptr<TileTask> makeTask(std::shared_ptr<DataSource> _source, int _x, double _priority) {
+    TileID tileId(_x, 0, 10);
+    auto task = std::make_shared<TileTask>(tileId, _source, -1);
+    task->setPriority(_priority);
+    return task;
+}
+
+TEST_CASE( "Pop tasks in priority order, proxies last", "[TileWorkQueue]" ) {
+    auto source = std::make_shared<QueueTestSource>();
+    TileWorkQueue queue(1);
+
+    auto proxy = makeTask(source, 0, 0);
+    proxy->setProxyState(true);
+
+    queue.push(makeTask(source, 1, 3));
+    queue.push(std::shared_ptr<TileTask>(proxy));
+    queue.push(makeTask(source, 2, 1));
+    queue.push(makeTask(source, 3, 2));
+
+    std::vector<int> order;
+    std::shared_ptr<TileTask> task;
+    while (queue.pop(0, task)) {
+        order.push_back(task->tileId().x);
+    }
+
+    REQUIRE(order == std::vector<int>({ 2, 3, 1, 0 }));
+    REQUIRE(queue.size() == 0);
+}
+
+TEST_CASE( "Reprioritize queued tasks", "[TileWorkQueue]" ) {
+    auto source = std::make_shared<QueueTestSource>();
+    TileWorkQueue queue(1);
+
+    std::vector<std::shared_ptr<TileTask>> tasks;
+    for (int i = 0; i < 8; i++) {
+        tasks.push_back(makeTask(source, i, i));
+        queue.push(std::shared_ptr<TileTask>(tasks.back()));
+    }
+
+    tasks[7]->setPriority(-1);
+    queue.reprioritize(*tasks[7]);
+
+    tasks[0]->setPriority(100);
+    queue.reprioritize(*tasks[0]);
+
+    std::shared_ptr<TileTask> task;
+    REQUIRE(queue.pop(0, task));
+    REQUIRE(task->tileId().x == 7);
+    REQUIRE(queue.pop(0, task));
+    REQUIRE(task->tileId().x == 1);
+
+    // Not queued anymore, must be ignored
+    queue.reprioritize(*tasks[7]);
+
+    int last = -1;
+    while (queue.pop(0, task)) { last = task->tileId().x; }
+    REQUIRE(last == 0);
+}
+
+TEST_CASE( "Drop canceled tasks and steal from other queues", "[TileWorkQueue]" ) {
+    auto source = std::make_shared<QueueTestSource>();
+    TileWorkQueue queue(4);
+
+    for (int i = 0; i < 16; i++) {
+        auto task = makeTask(source, i, i);
+        if (i % 2) { task->cancel(); }
+        queue.push(std::move(task));
+    }
+    REQUIRE(queue.size() == 16);
+
+    // Worker 0 drains all queues
+    int count = 0;
+    std::shared_ptr<TileTask> task;
+    while (queue.pop(0, task)) {
+        REQUIRE(!task->isCanceled());
+        count++;
+    }
+
+    REQUIRE(count == 8);
+    REQUIRE(queue.size() == 0);
+}
+
+TEST_CASE( "Compare source generations only between tasks of the same source", "[TileWorkQueue]" ) {
+    auto sourceA = std::make_shared<QueueTestSource>();
+    auto sourceB = std::make_shared<QueueTestSource>();
+    TileWorkQueue queue(1);
+
+    // Task of the first generation of B
+    auto stale = makeTask(sourceB, 0, 0);
+
+    // B is now a generation ahead of A
+    sourceB->clearData();
+
+    queue.push(makeTask(sourceA, 1, 2));
+    queue.push(makeTask(sourceB, 2, 1));
+    queue.push(makeTask(sourceA, 3, 3));
+    queue.push(std::shared_ptr<TileTask>(stale));
+
+    std::vector<int> order;
+    std::shared_ptr<TileTask> task;
+    while (queue.pop(0, task)) {
+        order.push_back(task->tileId().x);
+    }
+
+    // Closer tiles first regardless of the source, the stale task of B last
+    REQUIRE(order == std::vector<int>({ 2, 1, 3, 0 }));
+
+    // A task becomes stale when its source is cleared after it was queued
+    auto a = makeTask(sourceA, 4, 0);
+    queue.push(std::shared_ptr<TileTask>(a));
+    queue.push(makeTask(sourceB, 5, 1));
+
+    sourceA->clearData();
+    queue.reprioritize(*a);
+
+    REQUIRE(queue.pop(0, task));
+    REQUIRE(task->tileId().x == 5);
+    REQUIRE(queue.pop(0, task));
+    REQUIRE(task->tileId().x == 4);
+}
@@ -0,0 +1,93 @@
+#include "catch.hpp"
+
+#include "util/pbfParser.h"
+#include "util/varint.h"
+
+#include <string>
+#include <vector>
+
+using namespace Tangram;
+
+static void putVarint(std::string& _buffer, uint64_t _value) {
+    while (_value >= 0x80) {
+        _buffer.push_back(char(_value | 0x80));
+        _value >>= 7;
+    }
+    _buffer.push_back(char(_value));
+}
+
+TEST_CASE("Varint::decode matches the scalar decoder on mixed runs") {
+    std::vector<uint32_t> values;
+    for (uint32_t i = 0; i < 1000; i++) {
+        // Long runs of single-byte values with some larger ones
+        values.push_back((i % 37 == 0) ? i * 100003 : i % 128);
+    }
+    values.push_back(0xffffffff);
+
+    std::string buffer;
+    for (auto v : values) { putVarint(buffer, v); }
+
+    std::vector<uint32_t> simd(values.size());
+    std::vector<uint32_t> scalar(values.size());
+
+    const char* a = buffer.data();
+    const char* b = buffer.data();
+    const char* end = buffer.data() + buffer.size();
+
+    REQUIRE(Varint::decode(a, end, simd.data(), simd.size()) == values.size());
+    REQUIRE(Varint::decodeScalar(b, end, scalar.data(), scalar.size()) == values.size());
+
+    REQUIRE(simd == values);
+    REQUIRE(scalar == values);
+    REQUIRE(a == end);
+    REQUIRE(b == end);
+}
+
+TEST_CASE("Varint::decode stops after the requested count") {
+    std::string buffer;
+    for (int i = 0; i < 40; i++) { putVarint(buffer, i); }
+
+    std::vector<uint32_t> out(20);
+    const char* data = buffer.data();
+
+    REQUIRE(Varint::decode(data, buffer.data() + buffer.size(), out.data(), 20) == 20);
+    REQUIRE(out[19] == 19);
+    REQUIRE((data - buffer.data()) == 20);
+}
+
+TEST_CASE("Varint::decode stops at an unterminated varint") {
+    std::string buffer;
+    for (int i = 0; i < 20; i++) { putVarint(buffer, 1); }
+    buffer.push_back(char(0x80));
+
+    std::vector<uint32_t> out(21);
+    const char* data = buffer.data();
+
+    REQUIRE(Varint::decode(data, buffer.data() + buffer.size(), out.data(), 21) == 20);
+}
+
+TEST_CASE("Varint::zigzag decodes signed values") {
+    REQUIRE(Varint::zigzag(0) == 0);
+    REQUIRE(Varint::zigzag(1) == -1);
+    REQUIRE(Varint::zigzag(2) == 1);
+    REQUIRE(Varint::zigzag(4095) == -2048);
+    REQUIRE(Varint::zigzag(0xfffffffe) == 2147483647);
+}
+
+TEST_CASE("PbfParser::getGeometry bounds a corrupt command repeat count by the data") {
+    std::string buffer;
+    // moveTo with the largest repeat count, but a single point
+    putVarint(buffer, (0x1fffffff << 3) | PbfParser::moveTo);
+    // Zigzag encoded 10, 20
+    putVarint(buffer, 20);
+    putVarint(buffer, 40);
+
+    PbfParser::ParserContext ctx(0);
+    ctx.tileExtent = 4096;
+
+    PbfParser::getGeometry(ctx, protobuf::message(buffer.data(), buffer.size()));
+
+    REQUIRE(ctx.geometry.params.size() <= buffer.size());
+    REQUIRE(ctx.geometry.sizes == std::vector<int>({ 1 }));
+    REQUIRE(ctx.geometry.tileCoordinates == std::vector<int32_t>({ 10, 20 }));
+}